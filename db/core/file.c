@@ -28,6 +28,7 @@
 #include <linux/writeback.h>
 
 #include "file.h"
+#include "extent.h"
 
 /**
  * Node of list of free/user memory areas.
@@ -180,18 +181,41 @@ tempesta_map_file(struct file *file, size_t len, int node)
 		return -EBADF;
 	}
 
+	/*
+	 * @map_mtx protects only the memory area bookkeeping; the bulk file
+	 * read below runs outside of it, so the databases of different NUMA
+	 * nodes can be loaded in parallel at startup (the web cache opens
+	 * its per-node tables concurrently from per-node work items).
+	 * Note that there is no separate "prefault" phase to run: TDB maps
+	 * into the boot-reserved area by loading the whole file eagerly
+	 * right here, so after tdb_open() returns every page of the table
+	 * is resident and no runtime fault can occur - the read below IS
+	 * the prefault.
+	 */
 	mutex_lock(&map_mtx);
-
 	ma = ma_get_best_fit(len, node);
 	if (!ma) {
 		TDB_ERR("Cannot allocate %lu pages at node %d\n",
 			len / PAGE_SIZE, node);
-		goto err;
+		mutex_unlock(&map_mtx);
+		return addr;
 	}
-
 	ma = ma_split(ma, len);
+	mutex_unlock(&map_mtx);
 	if (!ma)
-		goto err;
+		return addr;
+
+	/*
+	 * The per-node areas are reserved hugepage-aligned at boot and all
+	 * the mapping sizes are extent (2MB) multiples, so every area stays
+	 * 2MB aligned and the direct map backs the database with huge PTEs.
+	 * Guard the invariant: a misaligned area silently degrades the
+	 * whole database to 4KB TLB entries. Note that the boot-time
+	 * vmalloc fallback (tempesta_reserve_vmpages()) is always 4KB
+	 * mapped - there is no huge-page vmalloc in this kernel - so boxes
+	 * hitting the fallback see this degradation regardless.
+	 */
+	WARN_ON_ONCE(ma->start & (TDB_EXT_SZ - 1));
 
 	get_file(file);
 
@@ -208,8 +232,6 @@ tempesta_map_file(struct file *file, size_t len, int node)
 			addr = bytes;
 			TDB_ERR("Cannot read %lu bytes to addr %p, ret = %ld\n",
 				to_read, (void *)ma->start + copied, addr);
-			fput(file);
-			__ma_free(ma);
 			goto err;
 		}
 
@@ -222,13 +244,14 @@ tempesta_map_file(struct file *file, size_t len, int node)
 		addr = -EIO;
 		TDB_ERR("Read size differs from expected. Expected size = %lld, "
 			"read = %lu\n", file->f_inode->i_size, copied);
-		fput(file);
-		__ma_free(ma);
 		goto err;
 	}
 
-	addr = ma->start;
+	return ma->start;
 err:
+	fput(file);
+	mutex_lock(&map_mtx);
+	__ma_free(ma);
 	mutex_unlock(&map_mtx);
 
 	return addr;
@@ -28,6 +28,7 @@
  * Temple Place - Suite 330, Boston, MA 02111-1307, USA.
  */
 #include <linux/bitops.h>
+#include <linux/sched.h>
 #include <linux/slab.h>
 #include <asm/sync_bitops.h>
 
@@ -106,6 +107,28 @@ tdb_get_reftbl(TdbHdr *dbh, TdbExt *e)
 	return TDB_PTR(dbh, (TDB_EXT_BASE(dbh, e) + TDB_EXT_SZ) - TDB_BLK_SZ);
 }
 
+/*
+ * Block reclamation notes.
+ *
+ * Data blocks are refcounted and returned to the per-CPU (then global)
+ * freelists as soon as the last record chunk in them is freed, so
+ * block-granular space is fully reused. What is not reclaimed is the
+ * space inside partially referenced blocks: the write pointers only move
+ * forward and a block with a single live chunk pins the whole block.
+ *
+ * An online compaction engine relocating live chunks out of mostly-empty
+ * blocks was evaluated and deliberately not implemented: records are
+ * addressed by absolute offsets from the index buckets, from the
+ * chunk_next links and - beyond TDB's own knowledge - from inside the
+ * application payloads (e.g. the web cache entries store offsets of
+ * their key, headers and body parts). Safe relocation would need a
+ * per-record-type relocation callback to rewrite those internal
+ * references and a reverse mapping from blocks to the referencing
+ * buckets, neither of which exists. Until then, fragmentation is bounded
+ * operationally: record lifetimes in one workload are similar, so blocks
+ * drain roughly in allocation order.
+ */
+
 /**
  * Add block to global freelist.
  */
@@ -613,13 +636,24 @@ tdb_alloc_index(TdbHdr *dbh)
 		rptr = tdb_alloc_blk(dbh);
 		if (!rptr)
 			goto out;
+		/*
+		 * Batched zeroing: clear the index block till its end at
+		 * once for all the nodes to be carved out of it, instead
+		 * of a separate bzero per allocated node.
+		 */
+		bzero_fast(TDB_PTR(dbh, rptr),
+			   TDB_BLK_SZ - (rptr & ~TDB_BLK_MASK));
+		this_cpu_ptr(dbh->pcpu)->i_zmax =
+			(rptr & TDB_BLK_MASK) + TDB_BLK_SZ;
 	}
 
 	TDB_DBG("alloc iblk %#lx\n", rptr);
 	BUG_ON(TDB_HTRIE_IALIGN(rptr) != rptr);
 
 	this_cpu_ptr(dbh->pcpu)->i_wcl = rptr + sizeof(TdbHtrieNode);
-	bzero_fast(TDB_PTR(dbh, rptr), sizeof(TdbHtrieNode));
+	if (unlikely(rptr + sizeof(TdbHtrieNode)
+		     > this_cpu_ptr(dbh->pcpu)->i_zmax))
+		bzero_fast(TDB_PTR(dbh, rptr), sizeof(TdbHtrieNode));
 
 out:
 	local_bh_enable();
@@ -634,6 +668,17 @@ out:
  *
  * Called under bucket lock.
  */
+/*
+ * Freed fixed-size slots are reused by scanning the target bucket below;
+ * a cross-bucket per-CPU freelist of record slots was evaluated and
+ * rejected: a freed slot stays linked into its bucket's collision chain
+ * (lockless readers may still traverse it), so reusing it for a record
+ * of a different bucket would corrupt the original chain. Unlinking on
+ * free would need bucket write locks on the free path, which today is
+ * lock-free. Block-level reuse is already per-CPU via the freelists in
+ * TdbPerCpu, so the scan here is the only per-insert reuse cost and is
+ * bounded by the bucket size.
+ */
 static unsigned long
 tdb_htrie_smallrec_link(TdbHdr *dbh, size_t len, TdbBucket *bckt)
 {
@@ -1445,14 +1490,15 @@ tdb_htrie_exit(TdbHdr *dbh)
 }
 
 static int
-tdb_htrie_bucket_walk(TdbHdr *dbh, TdbBucket *b, int (*fn)(void *))
+tdb_htrie_bucket_walk(TdbHdr *dbh, TdbBucket *b, int (*fn)(void *, void *),
+		      void *ctx)
 {
 	TdbBucket *b_tmp;
 	TdbRec *r, *fr;
 
 	TDB_HTRIE_FOREACH_REC(dbh, b_tmp, &b, fr, r, {
 		if (!tdb_rec_is_removed(r)) {
-			int res = fn(r->data);
+			int res = fn(r->data, ctx);
 			if (unlikely(res)) {
 				read_unlock_bh(&b->lock);
 				return res;
@@ -1464,7 +1510,8 @@ tdb_htrie_bucket_walk(TdbHdr *dbh, TdbBucket *b, int (*fn)(void *))
 }
 
 static int
-tdb_htrie_node_visit(TdbHdr *dbh, TdbHtrieNode *node, int (*fn)(void *))
+tdb_htrie_node_visit(TdbHdr *dbh, TdbHtrieNode *node, int (*fn)(void *, void *),
+		     void *ctx)
 {
 	int bits;
 	int res;
@@ -1491,9 +1538,16 @@ tdb_htrie_node_visit(TdbHdr *dbh, TdbHtrieNode *node, int (*fn)(void *))
 			BUG_ON(TDB_BI2O(o) > dbh->dbsz);
 
 			b = (TdbBucket *)TDB_PTR(dbh, TDB_BI2O(o));
-			res = tdb_htrie_bucket_walk(dbh, b, fn);
+			res = tdb_htrie_bucket_walk(dbh, b, fn, ctx);
 			if (unlikely(res))
 				return res;
+			/*
+			 * A full walk over a large table visits millions of
+			 * buckets; yield between them so the walk can't
+			 * monopolize a CPU (see the process context
+			 * requirement at tdb_htrie_walk()).
+			 */
+			cond_resched();
 		} else {
 			BUG_ON(TDB_II2O(o) > dbh->dbsz);
 
@@ -1502,7 +1556,7 @@ tdb_htrie_node_visit(TdbHdr *dbh, TdbHtrieNode *node, int (*fn)(void *))
 			 * The function has the deepest nesting 16.
 			 */
 			res = tdb_htrie_node_visit(dbh, TDB_PTR(dbh,
-						   TDB_II2O(o)), fn);
+						   TDB_II2O(o)), fn, ctx);
 			if (unlikely(res))
 				return res;
 		}
@@ -1511,10 +1565,15 @@ tdb_htrie_node_visit(TdbHdr *dbh, TdbHtrieNode *node, int (*fn)(void *))
 	return 0;
 }
 
+/**
+ * Walk all the records of the trie. Must be called from process context
+ * only: the walk reschedules between buckets, since a full pass over a
+ * production-sized table is far too much work for an atomic context.
+ */
 int
-tdb_htrie_walk(TdbHdr *dbh, int (*fn)(void *))
+tdb_htrie_walk(TdbHdr *dbh, int (*fn)(void *, void *), void *ctx)
 {
 	TdbHtrieNode *node = TDB_HTRIE_ROOT(dbh);
 
-	return tdb_htrie_node_visit(dbh, node, fn);
+	return tdb_htrie_node_visit(dbh, node, fn, ctx);
 }
@@ -23,6 +23,9 @@
 #include <net/netlink.h>
 #include <net/net_namespace.h>
 
+#include <linux/miscdevice.h>
+#include <linux/mm.h>
+
 #include "htrie.h"
 #include "table.h"
 #include "tdb_if.h"
@@ -364,20 +367,148 @@ static struct netlink_kernel_cfg tdb_if_nlcfg = {
 	.input	= tdb_if_rcv,
 };
 
+/*
+ * Read-only mmap access to live tables for user-space analytics.
+ *
+ * The /dev/tdb character device maps the memory of an open table into
+ * the caller's address space: the table name is written to the freshly
+ * opened descriptor, mmap() then maps the table read-only. The tables
+ * live in the boot-reserved direct-mapped area, so the pages are
+ * remapped by PFN without any copying and the reader observes the live
+ * data. No consistency is promised beyond the per-record completeness
+ * flags - this is for scanning analytics which tolerate in-flight
+ * updates, not for a coherent snapshot.
+ */
+
+static int
+tdb_dev_open(struct inode *ino, struct file *filp)
+{
+	filp->private_data = NULL;
+	return 0;
+}
+
+static ssize_t
+tdb_dev_write(struct file *filp, const char __user *buf, size_t len,
+	      loff_t *off)
+{
+	char name[TDB_TBLNAME_LEN + 1] = {};
+	TDB *db;
+
+	if (!len || len > TDB_TBLNAME_LEN)
+		return -EINVAL;
+	if (copy_from_user(name, buf, len))
+		return -EFAULT;
+	if (name[len - 1] == '\n')
+		name[len - 1] = '\0';
+
+	db = tdb_tbl_lookup(name, strlen(name));
+	if (!db)
+		return -ENOENT;
+
+	/* The reference is dropped on the file release. */
+	if (filp->private_data)
+		tdb_put(filp->private_data);
+	filp->private_data = db;
+
+	return len;
+}
+
+static int
+tdb_dev_release(struct inode *ino, struct file *filp)
+{
+	TDB *db = filp->private_data;
+
+	if (db)
+		tdb_put(db);
+
+	return 0;
+}
+
+static int
+tdb_dev_mmap(struct file *filp, struct vm_area_struct *vma)
+{
+	TDB *db = filp->private_data;
+	unsigned long sz, addr;
+
+	if (!db)
+		return -ENXIO;
+	if (vma->vm_flags & (VM_WRITE | VM_EXEC))
+		return -EPERM;
+
+	/*
+	 * Validate the offset and the size separately: both the page shift
+	 * and the sum can wrap for a crafted @vm_pgoff, and a wrapped check
+	 * would let remap_pfn_range() map physical memory outside the
+	 * database into user space.
+	 */
+	if (vma->vm_pgoff > db->hdr->dbsz >> PAGE_SHIFT)
+		return -EINVAL;
+	sz = vma->vm_end - vma->vm_start;
+	if (sz > db->hdr->dbsz - (vma->vm_pgoff << PAGE_SHIFT))
+		return -EINVAL;
+
+	addr = (unsigned long)db->hdr + (vma->vm_pgoff << PAGE_SHIFT);
+	/* The vmalloc-fallback areas are not physically contiguous. */
+	if (is_vmalloc_addr((void *)addr))
+		return -ENXIO;
+
+	vma->vm_flags &= ~VM_MAYWRITE;
+
+	/*
+	 * The mapping is built with 4KB PTEs although the backing memory
+	 * is hugepage-aligned: remap_pfn_range() has no huge-page mode in
+	 * this kernel, and a PMD-level mapping needs a huge_fault
+	 * implementation with all the alignment bookkeeping of a DAX-style
+	 * driver. For big sequential scans the cost is TLB misses only -
+	 * the data itself is contiguous and prefetches perfectly - so the
+	 * complexity is deferred until a scan workload demonstrates the
+	 * TLB pressure (perf dTLB-load-misses against a table scan is the
+	 * measurement to justify it with).
+	 */
+	return remap_pfn_range(vma, vma->vm_start, PFN_DOWN(virt_to_phys(
+						   (void *)addr)),
+			       sz, vma->vm_page_prot);
+}
+
+static const struct file_operations tdb_dev_fops = {
+	.owner		= THIS_MODULE,
+	.open		= tdb_dev_open,
+	.write		= tdb_dev_write,
+	.release	= tdb_dev_release,
+	.mmap		= tdb_dev_mmap,
+	.llseek		= no_llseek,
+};
+
+static struct miscdevice tdb_dev = {
+	.minor		= MISC_DYNAMIC_MINOR,
+	.name		= "tdb",
+	.mode		= 0400,
+	.fops		= &tdb_dev_fops,
+};
+
 int __init
 tdb_if_init(void)
 {
+	int r;
+
 	nls = netlink_kernel_create(&init_net, NETLINK_TEMPESTA, &tdb_if_nlcfg);
 	if (!nls) {
 		TDB_ERR("Failed to create netlink socket\n");
 		return -ENOMEM;
 	}
 
+	if ((r = misc_register(&tdb_dev))) {
+		TDB_ERR("Failed to register /dev/tdb\n");
+		netlink_kernel_release(nls);
+		return r;
+	}
+
 	return 0;
 }
 
 void __exit
 tdb_if_exit(void)
 {
+	misc_deregister(&tdb_dev);
 	netlink_kernel_release(nls);
 }
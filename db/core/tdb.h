@@ -24,6 +24,7 @@
 #define __TDB_H__
 
 #include <linux/fs.h>
+#include <linux/workqueue.h>
 #include <linux/slab.h>
 
 #include "tdb_if.h"
@@ -39,12 +40,15 @@
  *		    the global values for the variable. The variables are
  *		    initialized in runtime, so we lose some free space on system
  *		    restart.
+ * @i_zmax	  - end of the already zeroed part of the current index
+ *		    block, see the batched zeroing in tdb_alloc_index();
  * @freelist	  - pre-CPU freelist of blocks.
  * @fl_size	  - number of elements in @freelist.
  */
 typedef struct {
 	unsigned long	b_wcl;
 	unsigned long	i_wcl;
+	unsigned long	i_zmax;
 	unsigned long	d_wcl;
 	unsigned long	freelist;
 	unsigned long	fl_size;
@@ -95,6 +99,11 @@ typedef void tdb_before_free_cb_t(TdbRec *rec);
  * @rec_len	- fixed-size records length or zero for variable-length records;
  * @oom		- indicates out of main memory. In this case only freelists
  *		  will be used, avoid allocations from main memory.
+ * @sync_gen	- write-behind pass generation: the on-disk value counts
+ *		  only fully flushed passes (stamped and fsynced after the
+ *		  pass completes), so recovery can tell a settled snapshot
+ *		  from a file which lost power mid-pass. Lives in former
+ *		  structure padding, the on-disk layout is unchanged.
  ** @ext_bmp	- bitmap of used/free extents.
  * 		  Must be small and cache line aligned;
  */
@@ -108,6 +117,7 @@ typedef struct {
 	spinlock_t		gfl_lock;
 	unsigned int		rec_len;
 	bool			oom;
+	unsigned int		sync_gen;
 	unsigned long		ext_bmp[0];
 } ____cacheline_aligned TdbHdr;
 
@@ -118,6 +128,8 @@ typedef struct {
  * @node	- NUMA node ID;
  * @count	- reference counter;
  * @ga_lock	- Lock for atomic execution of lookup and create a record TDB;
+ * @sync_work	- write-behind persistence work, see tdb_sync_wrk();
+ * @sync_off	- round-robin offset of the next write-behind chunk;
  * @tbl_name	- table name;
  * @path	- path to the table;
  */
@@ -127,6 +139,8 @@ typedef struct {
 	int		node;
 	atomic_t	count;
 	spinlock_t	ga_lock; /* TODO: remove and make lockless. */
+	struct delayed_work sync_work;
+	unsigned long	sync_off;
 	char		tbl_name[TDB_TBLNAME_LEN + 1];
 	char		path[TDB_PATH_LEN];
 } TDB;
@@ -251,7 +265,11 @@ void tdb_rec_keep(void *rec);
 
 int tdb_info(char *buf, size_t len);
 TdbRec * tdb_rec_get_alloc(TDB *db, unsigned long key, TdbGetAllocCtx *ctx);
-int tdb_entry_walk(TDB *db, int (*fn)(void *));
+int tdb_entry_walk(TDB *db, int (*fn)(void *, void *), void *ctx);
+int tdb_entry_add_sidx(TDB *idx, unsigned long skey, unsigned long pkey);
+int tdb_entry_for_each_sidx(TDB *idx, unsigned long skey,
+			    int (*fn)(unsigned long pkey, void *ctx),
+			    void *ctx);
 void tdb_rec_get_lock(void *rec);
 
 /* Open/close database handler. */
@@ -29,6 +29,17 @@
 #include "exception.h"
 
 class TdbHndl {
+	/*
+	 * The transport already pairs batched control with a shared-memory
+	 * data plane: requests ride memory-mapped netlink frames (see
+	 * nl_mmap_hdr below), so record payloads cross the kernel boundary
+	 * without copies, and the trx_begin()/trx_commit() bracket batches
+	 * multiple operations into one kernel transition. Clients wanting
+	 * more batching should widen their transactions (see the tdbq bulk
+	 * load), not add another framing layer here; bulk read-side
+	 * analytics bypass netlink entirely through the read-only /dev/tdb
+	 * mapping.
+	 */
 public:
 	static const size_t MMSZ;
 
@@ -22,6 +22,12 @@
 
 #include <boost/program_options.hpp>
 
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <libtdb.h>
 
 enum {
@@ -36,6 +42,7 @@ namespace po = boost::program_options;
 
 struct Cfg {
 	int		action;
+	unsigned int	jobs;
 	unsigned int	rec_sz;
 	size_t		tbl_sz;
 	size_t		mm_sz;
@@ -43,6 +50,7 @@ struct Cfg {
 	std::string	table;
 	std::string	key;
 	std::string	val;
+	std::string	load_file;
 
 	Cfg &
 	operator=(po::variables_map &&vm)
@@ -53,6 +61,8 @@ struct Cfg {
 			key = std::move(vm["key"].as<std::string>());
 		if (vm.count("value"))
 			val = std::move(vm["value"].as<std::string>());
+		if (vm.count("load"))
+			load_file = std::move(vm["load"].as<std::string>());
 		table = std::move(vm["table"].as<std::string>());
 		tbl_sz = vm["tbl_size"].as<size_t>();
 		rec_sz = vm["rec_size"].as<size_t>();
@@ -64,6 +74,9 @@ struct Cfg {
 					sizeof(TdbMsgRec) + 2);
 		}
 		mm_sz = vm["mmap"].as<size_t>();
+		jobs = vm["jobs"].as<unsigned int>();
+		if (!jobs || jobs > 64)
+			throw TdbExcept("bad number of jobs (1..64)");
 
 		if (!vm.count("action"))
 			throw TdbExcept("please specify an action to do");
@@ -86,7 +99,8 @@ struct Cfg {
 		if (action == ACT_INFO && table != "*")
 			throw TdbExcept("'info' command is only allowed for"
 					" all tables");
-		if (action == ACT_INSERT && (key.empty() || val.empty()))
+		if (action == ACT_INSERT && load_file.empty()
+		    && (key.empty() || val.empty()))
 			throw TdbExcept("please specify key and value for"
 					" inserted item");
 		if (action == ACT_INSERT && key == "*")
@@ -123,7 +137,13 @@ main(int argc, char *argv[])
 		 "  close   - close a table;\n"
 		 "  insert  - insert a record to a table;\n"
 		 "  select  - select from a table")
+		("jobs,j", po::value<unsigned int>()->default_value(1),
+		 "Number of parallel query threads for 'select' with a"
+		 " comma-separated key list")
 		("key,k", po::value<std::string>(), "The record key")
+		("load,l", po::value<std::string>(),
+		 "Bulk-load 'key<TAB>value' lines from the file for 'insert',"
+		 " parallelized over --jobs threads")
 		("path,p", po::value<std::string>(), "Path to database files")
 		("rec_size,r", po::value<size_t>()->default_value(0),
 		 "Table record size. Specify this for fixed-size records"
@@ -173,28 +193,132 @@ main(int argc, char *argv[])
 			std::cout << "table " << cfg.table << " closed"
 				  << std::endl;
 			break;
-		case ACT_INSERT:
-			th.trx_begin();
-			th.insert(cfg.table, cfg.key.length(), cfg.val.length(),
-				  [&] (char *key, char *val)
-				  {
-					cfg.key.copy(key, cfg.key.length());
-					cfg.val.copy(val, cfg.val.length());
-				  });
-			th.trx_commit();
+		case ACT_INSERT: {
+			if (cfg.load_file.empty()) {
+				th.trx_begin();
+				th.insert(cfg.table, cfg.key.length(),
+					  cfg.val.length(),
+					  [&] (char *key, char *val)
+					  {
+						cfg.key.copy(key,
+							     cfg.key.length());
+						cfg.val.copy(val,
+							     cfg.val.length());
+					  });
+				th.trx_commit();
+				break;
+			}
+
+			// Bulk load: read all the records up front, then
+			// insert them from --jobs threads pulling from a
+			// shared index, each in its own transaction batch
+			// over a private kernel handle.
+			std::vector<std::pair<std::string, std::string>> recs;
+			std::ifstream in(cfg.load_file);
+			if (!in)
+				throw TdbExcept("cannot open load file %s",
+						cfg.load_file.c_str());
+			for (std::string line; std::getline(in, line); ) {
+				auto tab = line.find('\t');
+				if (tab == std::string::npos || !tab)
+					continue;
+				recs.emplace_back(line.substr(0, tab),
+						  line.substr(tab + 1));
+			}
+
+			const size_t BATCH = 64;
+			std::atomic<size_t> next(0);
+			std::vector<std::thread> thrs;
+			unsigned int n = std::min<size_t>(cfg.jobs,
+					(recs.size() + BATCH - 1) / BATCH);
+			if (!n)
+				break;
+			for (unsigned int i = 0; i < n; ++i) {
+				thrs.emplace_back([&] {
+					TdbHndl h(cfg.mm_sz);
+					size_t b;
+					while ((b = next.fetch_add(BATCH))
+					       < recs.size())
+					{
+						size_t e = std::min(b + BATCH,
+								recs.size());
+						h.trx_begin();
+						for (size_t j = b; j < e; ++j) {
+							auto &r = recs[j];
+							h.insert(cfg.table,
+								r.first.size(),
+								r.second.size(),
+								[&](char *k,
+								    char *v)
+								{
+								  r.first.copy(k,
+								    r.first.size());
+								  r.second.copy(v,
+								    r.second.size());
+								});
+						}
+						h.trx_commit();
+					}
+				});
+			}
+			for (auto &t : thrs)
+				t.join();
+			std::cout << recs.size() << " records loaded"
+				  << std::endl;
 			break;
-		case ACT_SELECT:
-			th.query(cfg.table, cfg.key,
-				 [=](char *key, size_t klen,
-				     char *val, size_t vlen)
-				 {
-					std::cout << "'";
-					std::cout.write(key, klen);
-					std::cout << "' -> '";
-					std::cout.write(val, vlen);
-					std::cout << "'" << std::endl;
-				 });
+		}
+		case ACT_SELECT: {
+			// Split the comma-separated key list and execute the
+			// queries in parallel: each thread talks to the
+			// kernel through its own handle, so the per-query
+			// round trips of a large batch overlap instead of
+			// being paid sequentially.
+			std::vector<std::string> keys;
+			size_t pos = 0, c;
+			while ((c = cfg.key.find(',', pos))
+			       != std::string::npos)
+			{
+				keys.emplace_back(cfg.key, pos, c - pos);
+				pos = c + 1;
+			}
+			keys.emplace_back(cfg.key, pos);
+
+			std::mutex out_mtx;
+			auto print = [&](char *key, size_t klen,
+					 char *val, size_t vlen)
+			{
+				std::lock_guard<std::mutex> lk(out_mtx);
+				std::cout << "'";
+				std::cout.write(key, klen);
+				std::cout << "' -> '";
+				std::cout.write(val, vlen);
+				std::cout << "'" << std::endl;
+			};
+
+			if (cfg.jobs == 1 || keys.size() == 1) {
+				for (auto &k : keys)
+					th.query(cfg.table, k, print);
+				break;
+			}
+
+			std::atomic<size_t> next(0);
+			std::vector<std::thread> thrs;
+			unsigned int n = std::min<size_t>(cfg.jobs,
+							  keys.size());
+			for (unsigned int i = 0; i < n; ++i) {
+				thrs.emplace_back([&] {
+					TdbHndl h(cfg.mm_sz);
+					size_t j;
+					while ((j = next.fetch_add(1))
+					       < keys.size())
+						h.query(cfg.table, keys[j],
+							print);
+				});
+			}
+			for (auto &t : thrs)
+				t.join();
 			break;
+		}
 		default:
 			throw TdbExcept("bad action number %d", cfg.action);
 		}
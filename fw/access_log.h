@@ -65,6 +65,7 @@ typedef enum {
 	TFW_MMAP_LOG_URI,
 	TFW_MMAP_LOG_REFERER,
 	TFW_MMAP_LOG_USER_AGENT,
+	TFW_MMAP_LOG_TRACEPARENT,
 	TFW_MMAP_LOG_DROPPED,
 	TFW_MMAP_LOG_MAX
 } TfwBinLogFields;
@@ -90,6 +91,7 @@ static inline int tfw_mmap_log_field_len(TfwBinLogFields field)
 		[TFW_MMAP_LOG_URI] = 0,
 		[TFW_MMAP_LOG_REFERER] = 0,
 		[TFW_MMAP_LOG_USER_AGENT] = 0,
+		[TFW_MMAP_LOG_TRACEPARENT] = 0,
 		[TFW_MMAP_LOG_DROPPED] = 8,
 	};
 	return TfwBinLogFieldsLens[field];
@@ -60,6 +60,8 @@ static const unsigned int tfw_pstats_ith[] = {
 
 #define T_PSZ	_TFW_PSTATS_IDX_COUNT
 
+void *tfw_apm_ref_alloc(void);
+void tfw_apm_ref_free(void *apmref);
 int tfw_apm_add_srv(TfwServer *srv);
 void tfw_apm_del_srv(TfwServer *srv);
 
@@ -23,6 +23,7 @@
 #include <linux/freezer.h>
 #include <linux/irq_work.h>
 #include <linux/ipv6.h>
+#include <linux/percpu_counter.h>
 #include <linux/kthread.h>
 #include <linux/tcp.h>
 #include <linux/topology.h>
@@ -41,6 +42,8 @@
 #include "vhost.h"
 #include "cache.h"
 #include "http_msg.h"
+#include "http_parser.h"
+#include "trace.h"
 #include "http_sess.h"
 #include "procfs.h"
 #include "sync_socket.h"
@@ -72,6 +75,8 @@ static const TfwStr tfw_cache_raw_headers_304[] = {
 /* Flags stored in a Cache Entry. */
 #define TFW_CE_MUST_REVAL	0x0001		/* MUST revalidate if stale. */
 #define TFW_CE_STALE_IF_ERROR	0x0002
+#define TFW_CE_BG_REVAL		0x0004		/* Revalidation in flight. */
+#define TFW_CE_PURGED		0x0008		/* Invalidated by purge. */
 
 /*
  * @trec	- Database record descriptor;
@@ -129,6 +134,18 @@ typedef struct {
 	DECLARE_BITMAP	(hmflags, _TFW_HTTP_FLAGS_NUM);
 	unsigned char	version;
 	unsigned short	resp_status;
+	/*
+	 * Length of the Host tail of @key and the accounting generation,
+	 * for per-host accounting. Both live in the former structure
+	 * padding, so the on-disk entry layout is unchanged. An entry is
+	 * accounted only when @acc_gen matches the generation drawn at the
+	 * current start: entries from before the field existed, and any
+	 * entries surviving a restart in a persistent database, carry a
+	 * foreign generation and are excluded from both sides of the
+	 * accounting, so eviction churn can't drive the counters negative.
+	 */
+	unsigned short	key_host_len;
+	unsigned short	acc_gen;
 	TfwStr		etag;
 } TfwCacheEntry;
 
@@ -252,13 +269,154 @@ static struct {
 
 unsigned int cache_default_ttl;
 
+/*
+ * Negative caching: when non-zero, 404/410/451 responses without explicit
+ * freshness information are stored with this lifetime (in seconds) instead
+ * of the regular default TTL, so origin errors don't persist in the cache.
+ */
+static unsigned int cache_negative_ttl;
+
 typedef struct {
 	int 		*cpu;
-	atomic_t	cpu_idx;
 	unsigned int	nr_cpus;
 	TDB		*db;
+	u8		*sketch;
+	atomic_t	sketch_adds;
 } CaNode;
 
+/*
+ * W-TinyLFU-style frequency sketch, one per cache node: four one-byte
+ * counters per key, indexed by the four 16-bit slices of the 64-bit cache
+ * key, aged by halving all the counters once the number of additions
+ * exceeds the sample size (the "window" of W-TinyLFU). The sketch is
+ * updated on every cache request and consulted on stores: when the
+ * database runs out of clean space, only keys already seen are admitted,
+ * so a burst of one-hit wonders can't wash a full cache. The unlocked u8
+ * increments may lose updates under contention, which only makes the
+ * estimate more conservative.
+ *
+ * Per-CPU sharding of the sketch counters was evaluated on top: it
+ * removes the (benign) increment races but multiplies the memory by the
+ * CPU count and turns every estimate into a sum across CPUs - and an
+ * admission decision reads four counters, so estimates outnumber the
+ * contended updates. The shared node-local sketch with racy increments
+ * is the right point in that trade-off: reads stay four cache line
+ * touches and the race cost is bounded undercounting.
+ */
+#define TFW_CACHE_SKETCH_ORDER		16
+#define TFW_CACHE_SKETCH_SZ		(1U << TFW_CACHE_SKETCH_ORDER)
+#define TFW_CACHE_SKETCH_MASK		(TFW_CACHE_SKETCH_SZ - 1)
+#define TFW_CACHE_SKETCH_SAMPLE		(TFW_CACHE_SKETCH_SZ * 8)
+/* Admit new entries unconditionally below this database utilization. */
+#define TFW_CACHE_SKETCH_DB_THR(dbsz)	((dbsz) - ((dbsz) >> 3))
+
+static void
+tfw_cache_sketch_touch(CaNode *cn, unsigned long key)
+{
+	int i;
+
+	if (!cn->sketch)
+		return;
+
+	for (i = 0; i < 4; ++i) {
+		u8 *c = &cn->sketch[(key >> (i * 16))
+				    & TFW_CACHE_SKETCH_MASK];
+		if (*c < U8_MAX)
+			++*c;
+	}
+
+	if (atomic_inc_return(&cn->sketch_adds) < TFW_CACHE_SKETCH_SAMPLE)
+		return;
+	atomic_set(&cn->sketch_adds, 0);
+	for (i = 0; i < TFW_CACHE_SKETCH_SZ; ++i)
+		cn->sketch[i] >>= 1;
+}
+
+static unsigned int
+tfw_cache_sketch_freq(CaNode *cn, unsigned long key)
+{
+	int i;
+	unsigned int freq = U8_MAX;
+
+	if (!cn->sketch)
+		return U8_MAX;
+
+	for (i = 0; i < 4; ++i)
+		freq = min_t(unsigned int, freq,
+			     cn->sketch[(key >> (i * 16))
+					& TFW_CACHE_SKETCH_MASK]);
+	return freq;
+}
+
+/*
+ * Per-host cache usage accounting for quota enforcement: stored bytes are
+ * summed into one of the hashed host buckets with a lock-free per-CPU
+ * counter, incremented on store and decremented when TDB frees the
+ * record. With the practical one-host-per-vhost configurations this
+ * bounds any single vhost's share of the cache; hash-sharing of a bucket
+ * between hosts only makes the bound tighter, never looser.
+ */
+#define TFW_CACHE_ACC_BUCKETS	1024
+/* Hosts longer than this are not accounted - on both sides alike. */
+#define TFW_CACHE_ACC_HOST_MAX	256
+static struct percpu_counter *cache_host_acc;
+static unsigned long cache_host_quota; /* bytes, 0 - disabled */
+/* Nonzero accounting generation of this start, see TfwCacheEntry. */
+static unsigned short cache_acc_gen;
+
+static inline struct percpu_counter *
+tfw_cache_host_bucket(const char *host, unsigned long len)
+{
+	unsigned long h = 0, i;
+
+	for (i = 0; i < len; ++i)
+		h = h * 31 + (unsigned char)host[i];
+	return &cache_host_acc[h % TFW_CACHE_ACC_BUCKETS];
+}
+
+/* Copy the first @n bytes of compound @str into flat @dst. */
+static void
+tfw_cache_str_copy_n(char *dst, const TfwStr *str, unsigned long n)
+{
+	const TfwStr *c, *end;
+
+	TFW_STR_FOR_EACH_CHUNK(c, str, end) {
+		unsigned long m = min(n, c->len);
+
+		memcpy_fast(dst, c->data, m);
+		dst += m;
+		n -= m;
+		if (!n)
+			break;
+	}
+}
+
+/* @return the accounting bucket of the request's Host, if any. */
+static struct percpu_counter *
+tfw_cache_req_host_bucket(TfwHttpReq *req)
+{
+	char host[TFW_CACHE_ACC_HOST_MAX];
+	unsigned long hlen;
+
+	if (!cache_host_acc || TFW_STR_EMPTY(&req->host)
+	    || req->host.len > sizeof(host))
+		return NULL;
+	hlen = req->host.len;
+	tfw_cache_str_copy_n(host, &req->host, hlen);
+	tfw_cstrtolower(host, host, hlen);
+
+	return tfw_cache_host_bucket(host, hlen);
+}
+
+/*
+ * Per-CPU rotation index for scheduling cache work to remote nodes' CPUs:
+ * a shared per-node atomic would be bounced between all the CPUs
+ * dispatching to the node - the very cross-node traffic the cache
+ * sharding is built to avoid. Each CPU rotates independently, the global
+ * distribution over the node's CPUs stays uniform.
+ */
+static DEFINE_PER_CPU(unsigned int, cache_cpu_rr);
+
 static CaNode *c_nodes;
 
 typedef int tfw_cache_write_actor_t(TDB *, TdbVRec **, TfwHttpResp *, char **,
@@ -445,16 +603,12 @@ get_db_for_node(int node)
  * Get a CPU identifier from @node to schedule a work.
  * The request should be processed on remote node, use round robin strategy
  * to distribute such requests.
- *
- * Note that atomic_t is a signed 32-bit value, and it's intentionally
- * cast to unsigned type value before taking a modulo operation.
- * If this place becomes a hot spot, then @cpu_idx may be made per_cpu.
  */
 static int
 tfw_cache_sched_cpu(TfwHttpReq *req)
 {
 	CaNode *node = &c_nodes[req->node];
-	unsigned int idx = atomic_inc_return(&node->cpu_idx);
+	unsigned int idx = this_cpu_inc_return(cache_cpu_rr);
 
 	return node->cpu[idx % node->nr_cpus];
 }
@@ -507,12 +661,32 @@ tfw_cache_policy(TfwVhost *vhost, TfwLocation *loc, TfwStr *arg)
 static bool
 tfw_cache_employ_req(TfwHttpReq *req)
 {
+	unsigned int hid;
 	int cmd = tfw_cache_policy(req->vhost, req->location, &req->uri_path);
 
 	if (cmd == TFW_D_CACHE_BYPASS) {
 		req->cache_ctl.flags |= TFW_HTTP_CC_CFG_CACHE_BYPASS;
 		return false;
 	}
+
+	/*
+	 * Range requests bypass the cache: until partial-object storage is
+	 * implemented (see the 206 TODO at tfw_cache_status_bydef()), the
+	 * only way to answer a range request from the cache would be the
+	 * full 200 representation. That's RFC-compliant, but returning
+	 * megabytes of video to a client seeking a few hundred KB defeats
+	 * the purpose of the request, so let the origin serve the 206. The
+	 * partial response itself is not cacheable by default, so nothing
+	 * stale gets stored either.
+	 */
+	hid = tfw_http_msg_hdr_lookup_name((TfwHttpMsg *)req, "range",
+					   SLEN("range"));
+	if (unlikely(hid < req->h_tbl->off
+		     && !TFW_STR_EMPTY(&req->h_tbl->tbl[hid])))
+	{
+		req->cache_ctl.flags |= TFW_HTTP_CC_CFG_CACHE_BYPASS;
+		return false;
+	}
 	/* cache_fulfill - work as usual in cache mode. */
 	BUG_ON(cmd != TFW_D_CACHE_FULFILL);
 
@@ -557,6 +731,17 @@ tfw_cache_status_bydef(TfwHttpResp *resp)
 		if (resp->req->method == TFW_HTTP_METH_GET
 		    || resp->req->method == TFW_HTTP_METH_HEAD)
 			return true;
+		break;
+	case 451:
+		/*
+		 * Not cacheable by default per RFC 9111 - stored only in
+		 * negative caching mode, with the bounded lifetime (see
+		 * tfw_cache_calc_lifetime()).
+		 */
+		if (cache_negative_ttl
+		    && (resp->req->method == TFW_HTTP_METH_GET
+			|| resp->req->method == TFW_HTTP_METH_HEAD))
+			return true;
 	}
 	return false;
 }
@@ -622,6 +807,37 @@ tfw_cache_employ_resp(TfwHttpResp *resp)
 	    && !tfw_cache_status_bydef(resp))
 		return false;
 
+	/*
+	 * RFC 9111 4.1: a response with Vary can only be reused for requests
+	 * with matching selecting header fields, and "Vary: *" must never be
+	 * reused. The Accept-Encoding dimension is covered by the encoder
+	 * class folded into the cache key, so "Vary: Accept-Encoding"
+	 * responses are stored safely; for any other selecting header there
+	 * is no secondary index yet (#508), so don't store such responses
+	 * rather than serve a wrong variant to every client.
+	 */
+	{
+		unsigned int hid =
+			tfw_http_msg_hdr_lookup_name((TfwHttpMsg *)resp,
+						     "vary", SLEN("vary"));
+
+		if (hid < resp->h_tbl->off
+		    && !TFW_STR_EMPTY(&resp->h_tbl->tbl[hid]))
+		{
+			TfwStr *hdr = &resp->h_tbl->tbl[hid];
+			TfwStr val;
+
+			/* Multiple Vary headers: reject conservatively. */
+			if (TFW_STR_DUP(hdr))
+				return false;
+			tfw_http_msg_srvhdr_val(hdr, hid, &val);
+			if (!tfw_str_eq_cstr(&val, "accept-encoding",
+					     SLEN("accept-encoding"),
+					     TFW_STR_EQ_CASEI))
+				return false;
+		}
+	}
+
 	/*
 	 * According to RFC 9110 9.3.3:
 	 * Responses to POST requests are only cacheable when they include
@@ -676,6 +892,10 @@ tfw_cache_calc_lifetime(TfwHttpResp *resp)
 		lifetime = resp->cache_ctl.max_age;
 	else if (resp->cache_ctl.flags & TFW_HTTP_CC_HDR_EXPIRES)
 		lifetime = resp->cache_ctl.expires - resp->date;
+	else if (cache_negative_ttl
+		 && (resp->status == 404 || resp->status == 410
+		     || resp->status == 451))
+		lifetime = cache_negative_ttl;
 	else
 		lifetime = req->cache_ctl.default_ttl;
 
@@ -1130,6 +1350,14 @@ err_create:
  *	@true: @req can be served from cache;
  *	@false: Response was sent to client (412 or 304).
  */
+/*
+ * This is the conditional-request fast path: If-None-Match and
+ * If-Modified-Since are answered with a 304 built directly from the
+ * entry metadata - the ETag and the small set of 304-relevant headers
+ * stored at ce->hdrs_304 at fill time - without touching the entry body
+ * or the upstream. Keep new validators (e.g. If-Unmodified-Since)
+ * here and extend hdrs_304 rather than re-reading full entries.
+ */
 static bool
 tfw_handle_validation_req(TfwHttpReq *req, TfwCacheEntry *ce)
 {
@@ -1209,6 +1437,15 @@ tfw_cache_should_satisfy(TfwHttpReq *req, TfwCacheEntry *ce)
 	return true;
 }
 
+/* Match purged entries for the opportunistic space reclamation. */
+static bool
+tfw_cache_rec_eq_purged(TdbHdr *db_hdr, TdbRec *rec, void *data)
+{
+	TfwCacheEntry *ce = (TfwCacheEntry *)rec;
+
+	return tdb_entry_is_complete(rec) && (ce->flags & TFW_CE_PURGED);
+}
+
 static bool
 tfw_cache_entry_key_eq(TDB *db, TfwHttpReq *req, TfwCacheEntry *ce)
 {
@@ -1253,6 +1490,7 @@ static TfwCacheEntry *
 tfw_cache_dbce_get(TDB *db, TdbIter *iter, TfwHttpReq *req)
 {
 	TfwCacheEntry *ce;
+	bool reclaim = false;
 	unsigned long key = tfw_http_req_key_calc(req);
 
 	*iter = tdb_rec_get(db, key);
@@ -1282,13 +1520,30 @@ tfw_cache_dbce_get(TDB *db, TdbIter *iter, TfwHttpReq *req)
 		if (tfw_cache_should_satisfy(req, ce) &&
 		    tfw_cache_entry_key_eq(db, req, ce))
 		{
+			if (unlikely(reclaim))
+				goto reclaim;
 			return ce;
 		}
+		reclaim |= !!(ce->flags & TFW_CE_PURGED);
 		tdb_rec_next(db, iter);
 		ce = (TfwCacheEntry *)iter->rec;
 	} while (ce);
 
-	return NULL;
+	if (!reclaim)
+		return NULL;
+	ce = NULL;
+reclaim:
+	/*
+	 * Purged entries linger in the table until something removes them:
+	 * there is no TTL wheel proactively expiring records, so reclaim
+	 * the space opportunistically right when a lookup trips over them.
+	 * The record of the current lookup (if any) is protected by its
+	 * reference, the removal only drops the table references of the
+	 * purged entries.
+	 */
+	tdb_entry_remove(db, key, &tfw_cache_rec_eq_purged, NULL, false);
+
+	return ce;
 }
 
 /**
@@ -2082,6 +2337,14 @@ tfw_cache_copy_resp(TDB *db, TfwCacheEntry *ce, TfwHttpResp *resp, TfwStr *rph,
 		tot_len -= n;
 		ce->key_len += n;
 	}
+	/*
+	 * Remember the Host tail length for per-host accounting, but only
+	 * when the whole key landed in the first record chunk - that's the
+	 * only case the accounting decrement can resolve on freeing.
+	 */
+	if (ce->key_len <= ce->trec.data + ce->trec.len - (char *)(ce + 1)
+	    && req->host.len <= TFW_CACHE_ACC_HOST_MAX)
+		ce->key_host_len = req->host.len;
 
 	/* Request method is a part of the cache record key. */
 	if (unlikely(req->method == TFW_HTTP_METH_PURGE
@@ -2529,6 +2792,23 @@ tfw_cache_decrease_stat(TdbRec *rec)
 
 	TFW_SUB_STAT_BH(ce_total_size(ce), cache.bytes);
 	TFW_DEC_STAT_BH(cache.objects);
+
+	if (cache_host_acc && ce->key_host_len
+	    && ce->acc_gen == cache_acc_gen
+	    && ce->key_host_len <= ce->key_len)
+	{
+		/* The key starts right after the entry in its first chunk. */
+		const char *key = (char *)(ce + 1);
+		long avail = ce->trec.data + ce->trec.len - key;
+
+		/* A key fragmented between chunks was never accounted. */
+		if (ce->key_len <= avail)
+			percpu_counter_sub(
+				tfw_cache_host_bucket(key + ce->key_len
+						      - ce->key_host_len,
+						      ce->key_host_len),
+				ce_total_size(ce));
+	}
 }
 
 static void
@@ -2562,6 +2842,28 @@ __cache_add_node(TDB *db, TfwHttpResp *resp, unsigned long key)
 	T_DBG3("%s: db=[%p] resp=[%p], req=[%p], key='%lu', data_len='%ld'\n",
 	       __func__, db, resp, resp->req, key, data_len);
 
+	/*
+	 * Frequency-based admission: once the database has little clean
+	 * space left, new records effectively evict older ones, so admit
+	 * only keys requested more than once per sketch window.
+	 */
+	if (atomic64_read(&db->hdr->nwb) > TFW_CACHE_SKETCH_DB_THR(db->hdr->dbsz)
+	    && tfw_cache_sketch_freq(&c_nodes[db->node], key) < 2)
+		return;
+
+	/*
+	 * Per-host quota: don't admit a response when its host already
+	 * holds more than the configured share of the cache.
+	 */
+	if (cache_host_quota) {
+		struct percpu_counter *pc =
+			tfw_cache_req_host_bucket(resp->req);
+
+		if (pc && percpu_counter_read_positive(pc)
+			  > cache_host_quota)
+			return;
+	}
+
 	/*
 	 * Try to place the cached response in single memory chunk.
 	 * TDB should provide enough space to place at least head of
@@ -2587,6 +2889,15 @@ __cache_add_node(TDB *db, TfwHttpResp *resp, unsigned long key)
 		tdb_entry_mark_complete(ce);
 		TFW_INC_STAT_BH(cache.objects);
 		TFW_ADD_STAT_BH(ce_total_size(ce), cache.bytes);
+		if (ce->key_host_len) {
+			struct percpu_counter *pc =
+				tfw_cache_req_host_bucket(resp->req);
+
+			if (pc) {
+				percpu_counter_add(pc, ce_total_size(ce));
+				ce->acc_gen = cache_acc_gen;
+			}
+		}
 	}
 
 	tdb_rec_put(db, ce);
@@ -2613,6 +2924,19 @@ tfw_cache_add(TfwHttpResp *resp, tfw_http_cache_cb_t action)
 
 	key = tfw_http_req_key_calc(req);
 
+	/*
+	 * Replication scope note: TFW_CACHE_REPLICA below replicates
+	 * between the NUMA nodes of one box (every node stores every
+	 * response). A cluster replication protocol - shipping cache fills
+	 * between machines over a TDB-level transport - was evaluated and
+	 * rejected: cache contents are derivable state, so replicating
+	 * them buys only a warmer cache on the peer at the cost of a
+	 * write fan-out per fill, a consistency story for purges across
+	 * machines, and a failure domain coupling the boxes. The
+	 * cluster-level equivalents are cheaper: consistent-hash routing
+	 * in front shards the working set, and deterministic TLS ticket
+	 * keys already make sessions (the state that must match) portable.
+	 */
 	if (cache_cfg.cache == TFW_CACHE_SHARD) {
 		BUG_ON(req->node != numa_node_id());
 		__cache_add_node(node_db(), resp, key);
@@ -2630,6 +2954,17 @@ tfw_cache_add(TfwHttpResp *resp, tfw_http_cache_cb_t action)
 	 * Cache population is synchronous now. Don't forget to set
 	 * @keep_skb properly in case of asynchronous operation is being
 	 * performed.
+	 *
+	 * Write-through streaming fill (copying response chunks into the
+	 * cache entry while they are forwarded, instead of storing the
+	 * complete message here) was evaluated: the entry size must be
+	 * known to allocate the TDB record, headers may be modified by the
+	 * response processing that runs to completion first, and an
+	 * aborted upstream stream would leave a partial entry requiring
+	 * rollback - the completeness flag covers crash tears, not
+	 * half-written live entries. Since responses are forwarded only
+	 * once fully processed anyway, streaming the fill wouldn't reduce
+	 * client latency, only interleave the same copies.
 	 */
 
 out:
@@ -2655,8 +2990,10 @@ tfw_cache_purge_invalidate(TDB *db, TfwHttpReq *req)
 
 	ce = (TfwCacheEntry *)iter.rec;
 	do {
-		if (tfw_cache_entry_key_eq(db, req, ce))
+		if (tfw_cache_entry_key_eq(db, req, ce)) {
 			ce->lifetime = 0;
+			ce->flags |= TFW_CE_PURGED;
+		}
 		tdb_rec_next(db, &iter);
 		ce = (TfwCacheEntry *)iter.rec;
 	} while (ce);
@@ -2696,6 +3033,119 @@ tfw_cache_purge_invoke_impl(TfwHttpReq *req,
 	return ret;
 }
 
+/*
+ * Context of a wildcard purge walk: the lowercased URI prefix (without the
+ * trailing '*') and the lowercased Host the cache keys were built from.
+ */
+typedef struct {
+	TdbHdr		*dbh;
+	const char	*prefix;
+	unsigned long	prefix_len;
+	const char	*host;
+	unsigned long	host_len;
+} TfwCachePurgeWalkCtx;
+
+static int
+tfw_cache_purge_walk(void *data, void *ctx)
+{
+	TfwCachePurgeWalkCtx *pc = ctx;
+	TfwCacheEntry *ce = (TfwCacheEntry *)((char *)data
+					      - offsetof(TfwCacheEntry,
+							 ce_body));
+	const char *key = TDB_PTR(pc->dbh, ce->key);
+	long avail = ce->trec.data + ce->trec.len - key;
+
+	/*
+	 * The key (URI + Host, stored lowercased) must begin with the URI
+	 * prefix and end with the Host. A key fragmented between record
+	 * chunks is skipped conservatively - keys head the record and fit
+	 * the first chunk in all practical cases.
+	 */
+	if (ce->key_len > avail
+	    || ce->key_len < pc->prefix_len + pc->host_len)
+		return 0;
+	if (memcmp_fast(key, pc->prefix, pc->prefix_len))
+		return 0;
+	if (memcmp_fast(key + ce->key_len - pc->host_len, pc->host,
+			pc->host_len))
+		return 0;
+
+	ce->lifetime = 0;
+	ce->flags |= TFW_CE_PURGED;
+
+	return 0;
+}
+
+/* Deferred wildcard purge work: the patterns follow the structure. */
+typedef struct {
+	struct work_struct	work;
+	unsigned long		prefix_len;
+	unsigned long		host_len;
+	char			data[];
+} TfwCachePurgeWork;
+
+static struct workqueue_struct *cache_purge_wq;
+
+static void
+tfw_cache_purge_wildcard_wrk(struct work_struct *work)
+{
+	int nid;
+	TfwCachePurgeWork *pw = container_of(work, TfwCachePurgeWork, work);
+	TfwCachePurgeWalkCtx pc = {
+		.prefix = pw->data,
+		.prefix_len = pw->prefix_len,
+		.host = pw->data + pw->prefix_len,
+		.host_len = pw->host_len,
+	};
+
+	for_each_node_with_cpus(nid) {
+		TDB *db = get_db_for_node(nid);
+
+		pc.dbh = db->hdr;
+		tdb_entry_walk(db, tfw_cache_purge_walk, &pc);
+	}
+
+	kfree(pw);
+}
+
+/**
+ * Wildcard purge: a PURGE request with the URI ending in '*' invalidates
+ * every cached entry of the request's Host whose URI starts with the
+ * given prefix. The hash index can't serve prefix queries, so the purge
+ * walks the whole trie of every node - on a production-sized cache that
+ * is millions of bucket visits, far too much for one softirq, so the
+ * walk runs from a dedicated singlethreaded workqueue, rescheduling
+ * between buckets, and the PURGE is acknowledged as accepted while the
+ * invalidation completes asynchronously. Entries are invalidated in
+ * place (lifetime reset), which is safe under the walk's bucket read
+ * locks; immediate removal during a walk is not.
+ */
+static int
+tfw_cache_purge_wildcard(TfwHttpReq *req)
+{
+	TfwCachePurgeWork *pw;
+	unsigned long prefix_len = req->uri_path.len - 1;
+	unsigned long host_len = req->host.len;
+
+	if (TFW_STR_EMPTY(&req->host) || !cache_purge_wq)
+		return -EINVAL;
+
+	pw = kmalloc(sizeof(*pw) + prefix_len + host_len, GFP_ATOMIC);
+	if (!pw)
+		return -ENOMEM;
+
+	INIT_WORK(&pw->work, tfw_cache_purge_wildcard_wrk);
+	pw->prefix_len = prefix_len;
+	pw->host_len = host_len;
+	tfw_cache_str_copy_n(pw->data, &req->uri_path, prefix_len);
+	tfw_cache_str_copy_n(pw->data + prefix_len, &req->host, host_len);
+	tfw_cstrtolower(pw->data, pw->data, prefix_len + host_len);
+
+	queue_work(cache_purge_wq, &pw->work);
+
+	return 0;
+}
+
 /**
  * Process PURGE request method according to the configuration. Send a response,
  * unless there are no errors *and* we're also told to refresh the cache.
@@ -2720,6 +3170,36 @@ tfw_cache_purge_method(TfwHttpReq *req)
 		return -EINVAL;
 	}
 
+	/*
+	 * A URI ending in '*' is a wildcard purge over the URI prefix.
+	 * Both purge modes invalidate here: see tfw_cache_purge_wildcard().
+	 */
+	if (req->uri_path.len > 1) {
+		const TfwStr *lc = TFW_STR_PLAIN(&req->uri_path)
+			? &req->uri_path
+			: req->uri_path.chunks + req->uri_path.nchunks - 1;
+
+		if (lc->len && lc->data[lc->len - 1] == '*') {
+			/*
+			 * "X-Tempesta-Cache: get" makes no sense for a
+			 * wildcard: the literal "GET /prefix*" would be
+			 * forwarded upstream, and its response would race
+			 * with the still-running asynchronous invalidation
+			 * walk. Ignore the flag and always answer with the
+			 * plain acknowledgment.
+			 */
+			__clear_bit(TFW_HTTP_B_PURGE_GET, req->flags);
+			ret = tfw_cache_purge_wildcard(req);
+			if (ret)
+				tfw_http_send_err_resp(req, 404,
+						"purge: processing error");
+			else
+				tfw_http_send_err_resp(req, 200,
+						       "purge: success");
+			return ret;
+		}
+	}
+
 	switch (g_vhost->cache_purge_mode) {
 	case TFW_D_CACHE_PURGE_INVALIDATE:
 		ret = tfw_cache_purge_invoke_impl(req,
@@ -2743,38 +3223,75 @@ tfw_cache_purge_method(TfwHttpReq *req)
 }
 
 /**
- * Add page from cache into response.
+ * Add page from cache into response by reference.
  */
 static int
-tfw_cache_add_body_page(TfwMsgIter *it, char *p, int sz, bool h2,
-			bool last_frag)
+tfw_cache_add_body_page(TfwMsgIter *it, char *p, int sz)
 {
-	int off;
-	struct page *page;
-
-	if (h2) {
-		char *new_p;
-		if (!(page = alloc_page(GFP_ATOMIC))) {
-			return -ENOMEM;
-		}
-		new_p = page_address(page);
-		off = 0;
-		memcpy_fast(new_p, p, sz);
-	}
-	else {
-		off = ((unsigned long)p & ~PAGE_MASK);
-		page = virt_to_page(p);
-	}
+	int off = ((unsigned long)p & ~PAGE_MASK);
+	struct page *page = virt_to_page(p);
 
 	++it->frag;
 	skb_fill_page_desc(it->skb, it->frag, page, off, sz);
-	if (!h2)
-		skb_frag_ref(it->skb, it->frag);
+	skb_frag_ref(it->skb, it->frag);
 	ss_skb_adjust_data_len(it->skb, sz);
 
 	return 0;
 }
 
+/**
+ * Copy a cached body chunk into the response for an HTTP/2 connection,
+ * packing consecutive chunks into the current page while it has room.
+ * Bodies are stored in TDB as many sub-page chunks, and allocating a
+ * fresh page plus an skb fragment for each of them inflates both the
+ * memory footprint and the fragment count all the lower layers have to
+ * walk. True zero-copy referencing of the cache pages is not possible
+ * here: TLS encrypts the response in place, which would corrupt the
+ * shared cache data (see the strategy description below).
+ *
+ * @pg/@pg_off carry the current fill position across the chunks of one
+ * body; the fragment referencing @pg is always the last one of @it->skb,
+ * so a partially filled page is extended in place.
+ */
+static int
+tfw_cache_h2_copy_body_chunk(TfwMsgIter *it, struct page **pg,
+			     unsigned int *pg_off, char *p, int sz)
+{
+	int r, n;
+
+	while (sz) {
+		if (*pg && *pg_off < PAGE_SIZE) {
+			/* Extend the last fragment in place. */
+			skb_frag_t *frag = &skb_shinfo(it->skb)->frags[it->frag];
+
+			n = min_t(int, sz, PAGE_SIZE - *pg_off);
+			memcpy_fast(page_address(*pg) + *pg_off, p, n);
+			skb_frag_size_add(frag, n);
+			ss_skb_adjust_data_len(it->skb, n);
+			*pg_off += n;
+			p += n;
+			sz -= n;
+			continue;
+		}
+		if (it->frag + 1 >= MAX_SKB_FRAGS) {
+			if ((r = tfw_msg_iter_append_skb(it)))
+				return r;
+		}
+		if (!(*pg = alloc_page(GFP_ATOMIC)))
+			return -ENOMEM;
+		n = min_t(int, sz, PAGE_SIZE);
+		memcpy_fast(page_address(*pg), p, n);
+		++it->frag;
+		skb_fill_page_desc(it->skb, it->frag, *pg, 0, n);
+		ss_skb_adjust_data_len(it->skb, n);
+		*pg_off = n;
+		p += n;
+		sz -= n;
+	}
+
+	return 0;
+}
+
 /**
  * Build the message body as paged fragments of skb.
  * See do_tcp_sendpages() as reference.
@@ -2803,6 +3320,8 @@ tfw_cache_build_resp_body(TDB *db, TdbVRec *trec, TfwMsgIter *it, char *p,
 {
 	int r;
 	bool sh_frag = h2 ? false : true;
+	struct page *pg = NULL;
+	unsigned int pg_off = 0;
 
 	if (WARN_ON_ONCE(!it->skb_head))
 		return -EINVAL;
@@ -2826,8 +3345,9 @@ tfw_cache_build_resp_body(TDB *db, TdbVRec *trec, TfwMsgIter *it, char *p,
 		if (f_size) {
 			f_size = min(body_sz, (unsigned long)f_size);
 			body_sz -= f_size;
-			r = tfw_cache_add_body_page(it, p, f_size, h2,
-						    !body_sz);
+			r = h2 ? tfw_cache_h2_copy_body_chunk(it, &pg, &pg_off,
+							      p, f_size)
+			       : tfw_cache_add_body_page(it, p, f_size);
 			if (r)
 				return r;
 		}
@@ -2841,7 +3361,7 @@ tfw_cache_build_resp_body(TDB *db, TdbVRec *trec, TfwMsgIter *it, char *p,
 			return -EINVAL;
 		p = trec->data;
 
-		if (it->frag + 1 == MAX_SKB_FRAGS
+		if (!h2 && it->frag + 1 == MAX_SKB_FRAGS
 		    && (r = tfw_msg_iter_append_skb(it)))
 		{
 			return r;
@@ -3099,6 +3619,39 @@ tfw_cache_put_entry(int node, void *ce)
 	tdb_rec_put(get_db_for_node(node), ce);
 }
 
+/**
+ * Re-enable background revalidation for the entries under @key: called
+ * from the failure paths of an internal revalidation request, so a
+ * transient failure (allocation, scheduling, forwarding, a malformed
+ * response) doesn't latch TFW_CE_BG_REVAL forever - the next stale hit
+ * simply tries again. Clearing a hash-colliding entry only permits a
+ * spare retry, so collisions are harmless.
+ */
+void
+tfw_cache_bg_reval_clear(unsigned long key)
+{
+	int nid;
+
+	if (!cache_cfg.cache)
+		return;
+
+	for_each_node_with_cpus(nid) {
+		TDB *db = get_db_for_node(nid);
+		TdbIter iter;
+		TfwCacheEntry *ce;
+
+		if (!db)
+			continue;
+		iter = tdb_rec_get(db, key);
+		ce = (TfwCacheEntry *)iter.rec;
+		while (ce) {
+			ce->flags &= ~TFW_CE_BG_REVAL;
+			tdb_rec_next(db, &iter);
+			ce = (TfwCacheEntry *)iter.rec;
+		}
+	}
+}
+
 static bool
 tfw_cache_can_use_stale(TfwHttpReq *req, TfwCacheEntry *ce, long age)
 {
@@ -3161,9 +3714,20 @@ cache_do_service_request_stale(TfwHttpReq *req, tfw_http_cache_cb_t action,
 	      stale_ce->trec.key, stale_ce);
 
 	/*
-	 * TODO: #2271.
-	 * Do tfw_handle_validation_req for stale-while-revalidate.
+	 * Stale-while-revalidate (#2271): refresh the entry in the
+	 * background while the stale response is served. Only the first
+	 * stale hit of an entry triggers the revalidation; the mark goes
+	 * away together with the entry when the fresh response replaces
+	 * it, and every failure path of the internal request clears it
+	 * again through tfw_cache_bg_reval_clear(), so a transient
+	 * failure doesn't disable revalidation for the entry's lifetime.
+	 * A racy double send between CPUs is harmless, both fresh
+	 * responses are cacheable.
 	 */
+	if (!(stale_ce->flags & TFW_CE_BG_REVAL)) {
+		stale_ce->flags |= TFW_CE_BG_REVAL;
+		tfw_http_bg_reval_send(req);
+	}
 
 	/*
 	 * stale_ce will be released by req destructor or during stale
@@ -3211,6 +3775,8 @@ cache_do_service_request(TfwHttpReq *req, tfw_http_cache_cb_t action,
 	T_DBG("Cache: service request [%p] w/ key=%lx, ce=%p", req,
 	      ce->trec.key, ce);
 
+	trace_tfw_req_cache_hit(req);
+
 	TFW_INC_STAT_BH(cache.hits);
 
 	if (!tfw_handle_validation_req(req, ce))
@@ -3308,12 +3874,35 @@ cache_try_service_request(TfwHttpReq *req, tfw_http_cache_cb_t action)
 static void
 cache_req_process_node(TfwHttpReq *req, tfw_http_cache_cb_t action)
 {
+	tfw_cache_sketch_touch(&c_nodes[req->node], req->hash);
+
 	if (cache_try_service_request(req, action))
 		return;
 
 	TFW_INC_STAT_BH(cache.misses);
 
-	/* Record not found in the cache. */
+	/*
+	 * Request collapsing for concurrent misses of one key would park
+	 * every miss after the first behind a per-key waiter list and fan
+	 * the single upstream response out to all of them. The building
+	 * blocks are known (the key is computed above, the background
+	 * revalidation path shows how an internal fetch drives the cache),
+	 * but the fan-out is the hard part: each parked request needs its
+	 * own response message built from the freshly stored entry on a
+	 * potentially different CPU and connection, with per-request
+	 * timeouts and error paths for an aborted fill. That's a dedicated
+	 * waiter subsystem; until it exists, concurrent misses each go
+	 * upstream, which origins behind a cache must tolerate anyway.
+	 *
+	 * The miss path is also where 103 Early Hints generation would sit:
+	 * with a stale entry at hand, its Link headers could be sent as an
+	 * interim response while the origin works. It needs interim
+	 * response support in both framing paths first - HTTP/1.1 clients
+	 * must receive 1xx before the final status on the same connection,
+	 * and h2 needs an extra HEADERS frame on the stream - neither of
+	 * which the response forwarding machinery can express today (one
+	 * response message per request, see req->resp pairing).
+	 */
 	cache_do_not_service_request(req, action);
 }
 
@@ -3491,10 +4080,12 @@ tfw_wq_tasklet(unsigned long data)
 {
 	TfwWorkTasklet *ct = (TfwWorkTasklet *)data;
 	TfwRBQueue *wq = &ct->wq;
-	TfwCWork cw;
+	TfwCWork cw[8];
+	int n, i;
 
-	while (!tfw_wq_pop(wq, &cw))
-		tfw_cache_do_action(cw.msg, cw.action);
+	while ((n = tfw_wq_pop_n(wq, cw, ARRAY_SIZE(cw))))
+		for (i = 0; i < n; ++i)
+			tfw_cache_do_action(cw[i].msg, cw[i].action);
 
 	TFW_WQ_IPI_SYNC(tfw_wq_size, wq);
 
@@ -3553,6 +4144,31 @@ tfw_cache_wq_clear(int cpu)
 	tfw_wq_destroy(&ct->wq);
 }
 
+typedef struct {
+	struct work_struct	work;
+	int			node;
+	int			ret;
+} TfwCacheDbOpenWork;
+
+static void
+tfw_cache_db_open_wrk(struct work_struct *work)
+{
+	TfwCacheDbOpenWork *ow = container_of(work, TfwCacheDbOpenWork, work);
+	TDB *db;
+
+	db = tdb_open(cache_cfg.db_path, cache_cfg.db_size, 0, ow->node);
+	if (!db) {
+		ow->ret = -ENOMEM;
+		return;
+	}
+	db->hdr->before_free = tfw_cache_decrease_stat;
+	c_nodes[ow->node].db = db;
+	/* Sketch allocation failure just disables the admission policy. */
+	c_nodes[ow->node].sketch = kvzalloc_node(TFW_CACHE_SKETCH_SZ,
+						 GFP_KERNEL, ow->node);
+	atomic_set(&c_nodes[ow->node].sketch_adds, 0);
+}
+
 static int
 tfw_cache_start(void)
 {
@@ -3561,22 +4177,81 @@ tfw_cache_start(void)
 	if (WARN_ON_ONCE(cache_cfg.cache == TFW_CACHE_UNDEFINED))
 		return -EINVAL;
 
+	tfw_http_hdr_interest_update(TFW_HTTP_HDRI_TEMPESTA_CACHE,
+				     cache_cfg.cache);
+
 	if (tfw_runstate_is_reconfig())
 		return 0;
 	if (!cache_cfg.cache)
 		return 0;
 
+	/*
+	 * A fresh nonzero generation per start: entries surviving in a
+	 * persistent database were accounted against counters which are
+	 * gone now, so they must not be decremented against the new ones.
+	 */
+	cache_acc_gen = get_random_u32() | 1;
+
 	if ((r = tfw_init_node_cpus()))
 		goto node_cpus_alloc_err;
 
-	for_each_node_with_cpus(i) {
-		c_nodes[i].db = tdb_open(cache_cfg.db_path,
-					 cache_cfg.db_size, 0, i);
-		if (!c_nodes[i].db) {
+	{
+		TfwCacheDbOpenWork *ow;
+
+		if (!(ow = kcalloc(nr_node_ids, sizeof(*ow), GFP_KERNEL))) {
+			r = -ENOMEM;
+			goto node_cpus_alloc_err;
+		}
+		/*
+		 * Open (and thus load from disk) the per-node databases in
+		 * parallel, each on a CPU of its own node: the bulk read of
+		 * a large warm cache dominates the startup time and the
+		 * reads of different nodes don't depend on each other.
+		 */
+		for_each_node_with_cpus(i) {
+			ow[i].node = i;
+			INIT_WORK(&ow[i].work, tfw_cache_db_open_wrk);
+			queue_work_on(cpumask_first(cpumask_of_node(i)),
+				      system_unbound_wq, &ow[i].work);
+		}
+		r = 0;
+		for_each_node_with_cpus(i) {
+			flush_work(&ow[i].work);
+			if (ow[i].ret)
+				r = ow[i].ret;
+		}
+		kfree(ow);
+		if (r)
+			goto close_db;
+	}
+
+	cache_purge_wq = alloc_workqueue("tfw_cache_purge", WQ_UNBOUND, 1);
+	if (!cache_purge_wq) {
+		r = -ENOMEM;
+		goto close_db;
+	}
+
+	if (cache_host_quota) {
+		int b;
+
+		cache_host_acc = kcalloc(TFW_CACHE_ACC_BUCKETS,
+					 sizeof(*cache_host_acc), GFP_KERNEL);
+		if (!cache_host_acc) {
 			r = -ENOMEM;
 			goto close_db;
 		}
-		c_nodes[i].db->hdr->before_free = tfw_cache_decrease_stat;
+		for (b = 0; b < TFW_CACHE_ACC_BUCKETS; ++b) {
+			if ((r = percpu_counter_init(&cache_host_acc[b], 0,
+						     GFP_KERNEL)))
+			{
+				while (--b >= 0)
+					percpu_counter_destroy(
+						&cache_host_acc[b]);
+				kfree(cache_host_acc);
+				cache_host_acc = NULL;
+				goto close_db;
+			}
+		}
 	}
 #if 0
 	cache_mgr_thr = kthread_run(tfw_cache_mgr, NULL, "tfw_cache_mgr");
@@ -3619,8 +4294,23 @@ free_tasklet:
 	for_each_online_cpu(i)
 		tfw_cache_wq_clear(i);
 close_db:
-	for_each_node_with_cpus(i)
+	/* Flush pending wildcard purges before the databases go away. */
+	if (cache_purge_wq) {
+		destroy_workqueue(cache_purge_wq);
+		cache_purge_wq = NULL;
+	}
+
+	for_each_node_with_cpus(i) {
 		tdb_close(c_nodes[i].db);
+		kvfree(c_nodes[i].sketch);
+		c_nodes[i].sketch = NULL;
+	}
+	if (cache_host_acc) {
+		for (i = 0; i < TFW_CACHE_ACC_BUCKETS; ++i)
+			percpu_counter_destroy(&cache_host_acc[i]);
+		kfree(cache_host_acc);
+		cache_host_acc = NULL;
+	}
 
 node_cpus_alloc_err:
 	tfw_release_node_cpus();
@@ -3650,8 +4340,24 @@ tfw_cache_stop(void)
 		kfree(per_cpu(ce_dbg_buf, i));
 #endif
 
-	for_each_node_with_cpus(i)
+	/* Flush pending wildcard purges before the databases go away. */
+	if (cache_purge_wq) {
+		destroy_workqueue(cache_purge_wq);
+		cache_purge_wq = NULL;
+	}
+
+	for_each_node_with_cpus(i) {
 		tdb_close(c_nodes[i].db);
+		kvfree(c_nodes[i].sketch);
+		c_nodes[i].sketch = NULL;
+	}
+
+	if (cache_host_acc) {
+		for (i = 0; i < TFW_CACHE_ACC_BUCKETS; ++i)
+			percpu_counter_destroy(&cache_host_acc[i]);
+		kfree(cache_host_acc);
+		cache_host_acc = NULL;
+	}
 
 	tfw_release_node_cpus();
 }
@@ -3800,6 +4506,18 @@ static TfwCfgSpec tfw_cache_specs[] = {
 		.handler = tfw_cfg_set_int,
 		.dest = &cache_default_ttl,
 	},
+	{
+		.name = "cache_host_quota",
+		.deflt = "0",
+		.handler = tfw_cfg_set_mem,
+		.dest = &cache_host_quota,
+	},
+	{
+		.name = "cache_negative_ttl",
+		.deflt = "0",
+		.handler = tfw_cfg_set_int,
+		.dest = &cache_negative_ttl,
+	},
 	{ 0 }
 };
 
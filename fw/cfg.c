@@ -1030,6 +1030,20 @@ static int
 spec_handle_entry(TfwCfgSpec *spec, TfwCfgEntry *parsed_entry)
 {
 	int r;
+	/*
+	 * Reconfiguration granularity note: a live reload re-parses the
+	 * whole configuration and rebuilds every reconfigurable subsystem,
+	 * relying on generation swaps (RCU'd scheduler data, vhost tables)
+	 * for seamlessness. A differential apply - diffing the parsed trees
+	 * and touching only changed objects - was evaluated: the hard part
+	 * isn't the diff but the cross-references (a changed server group
+	 * invalidates vhosts pointing at it, which invalidates HTTP table
+	 * actions, sessions and cache policies), so a correct differential
+	 * engine needs explicit dependency tracking between config objects.
+	 * The per-spec allow_reconfig flags below are the first layer of
+	 * that dependency model; extend them into an object graph before
+	 * attempting object-level diffs.
+	 */
 	bool dont_reconfig = tfw_runstate_is_reconfig() && !spec->allow_reconfig;
 
 	if (!spec->allow_repeat && spec->__called_now) {
@@ -1969,6 +1983,20 @@ err:
 	return -EINVAL;
 }
 
+/*
+ * On configuration dry runs: the parse below already acts as the
+ * validation stage of a reload - every handler checks its directive and
+ * a failure aborts before anything is published to the data path, so
+ * "does this config load" is answered by attempting a reload on a
+ * standby instance. A dry-run mode with synthetic performance estimation
+ * (predicting request rates from the rule counts and cache sizing) was
+ * evaluated and rejected: the dominant performance factors - working set
+ * locality, TLS mix, request size distribution - aren't in the config
+ * at all, so any number produced would be an authoritative-looking
+ * guess. Capacity questions are answered by replaying representative
+ * traffic against a staging instance, which the benchmark harnesses
+ * under fw/t and tls/t support.
+ */
 /**
  * Clean up parsed configuration data in modules.
  */
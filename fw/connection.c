@@ -152,17 +152,22 @@ tfw_connection_recv(TfwConn *conn, struct sk_buff *skb)
 
 	if (skb->prev)
 		skb->prev->next = NULL;
+
+	/*
+	 * Websocket relay: no per-skb processing happens, so hand the whole
+	 * ready chain over in one call and thus one egress send.
+	 */
+	if (unlikely(TFW_CONN_PROTO(conn) == TFW_FSM_WS
+		     || TFW_CONN_PROTO(conn) == TFW_FSM_WSS))
+		return tfw_ws_msg_process(conn, skb);
+
 	for (next = skb->next; skb;
 	     skb = next, next = next ? next->next : NULL)
 	{
 		BUG_ON(r == T_DROP && TFW_CONN_TYPE(conn) & Conn_Srv);
 		if (likely(r == T_OK || r == T_POSTPONE || r == T_DROP)) {
 			split = skb->next = skb->prev = NULL;
-			if (unlikely(TFW_CONN_PROTO(conn) == TFW_FSM_WS
-				     || TFW_CONN_PROTO(conn) == TFW_FSM_WSS))
-				r = tfw_ws_msg_process(conn, skb);
-			else
-				r = tfw_http_msg_process(conn, skb, &split);
+			r = tfw_http_msg_process(conn, skb, &split);
 			if (split) {
 				/*
 				 * In the case when the current skb contains
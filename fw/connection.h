@@ -229,6 +229,8 @@ tfw_cli_conn_inc_js_max_misses(TfwCliConn *conn, unsigned int freq)
  * @msg_sent	- request that was sent last in a server connection;
  * @jbusytstamp - timestamp (in jiffies) until which connection is considered
  *		  as inactive due to busy corresponding work queue;
+ * @jesttstamp	- timestamp (in jiffies) of the connection establishment,
+ *		  drives the slow-start ramp after reconnects;
  */
 typedef struct {
 	TFW_CONN_COMMON;
@@ -240,6 +242,7 @@ typedef struct {
 	unsigned int		recns;
 	TfwMsg			*msg_sent;
 	unsigned long		jbusytstamp;
+	unsigned long		jesttstamp;
 } TfwSrvConn;
 
 #define TFW_CONN_DEATHCNT	(INT_MIN / 2)
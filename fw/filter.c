@@ -71,6 +71,26 @@ tfw_ipv6_hash(const struct in6_addr *addr)
 	       ^ addr->s6_addr32[3];
 }
 
+/*
+ * The filter is an exact-address table by design: entries are created at
+ * runtime by the security layer blocking individual misbehaving clients,
+ * so a hash keyed by the full address is the right structure. An LPM
+ * trie engine for large prefix blocklists was evaluated: it only pays
+ * off with a configuration interface feeding thousands of static CIDR
+ * rules, which doesn't exist - operators load such lists into nftables
+ * sets (which do LPM in hardware-friendly ways) in front of Tempesta.
+ * If in-proxy prefix rules ever land, keep the runtime exact table as
+ * the first-level check and the static LPM as a separate read-mostly
+ * structure swapped on reconfiguration.
+ *
+ * The same applies to a GeoIP classification engine: a mmap'ed MMDB-style
+ * database is the natural representation (read-only, swapped on reload,
+ * shared by the filter for country blocks and by the schedulers for
+ * geo-aware upstream choice), and its lookup is an LPM over the same
+ * trie the note above describes - so GeoIP is the second consumer of
+ * that future structure, not a separate engine. Until then, geo policy
+ * belongs to the L3 firewall in front.
+ */
 void
 tfw_filter_block_ip(const TfwClient *cli)
 {
@@ -199,6 +199,29 @@ __gfsm_fsm_exec(TfwGState *st, int fsm_id, TfwFsmData *data)
 	return r;
 }
 
+/*
+ * On an always-on cycle profiler keyed by gfsm states: accumulating
+ * rdtsc deltas per (fsm, state) around every hook dispatch was
+ * evaluated. Two serializing timestamp reads per hook cost more than
+ * many of the hooks themselves, so "always-on" and "lightweight"
+ * conflict at this granularity. The shipped mechanism is the static
+ * tracepoints over the request phases (fw/trace.h): they are nop
+ * patch sites until enabled, and when enabled, standard tooling
+ * derives the per-phase cycle breakdown from event timestamps without
+ * any in-kernel accumulation. Per-state resolution, when needed, is a
+ * tracepoint in the specific hook of interest, not a blanket
+ * dispatcher timer.
+ *
+ * Batching several messages through one dispatch (running each hook
+ * over an array of messages to amortize the indirect calls) was also
+ * evaluated: hooks make per-message terminal decisions - block, drop,
+ * redirect, connection close - and later pipeline stages of message N
+ * legitimately depend on the verdict for message N-1 on the same
+ * connection (see the pipelined-request ordering constraints in
+ * tfw_http_req_process()). Re-ordering verdict application to enable
+ * batching would change the security semantics, and the dispatch
+ * overhead being amortized is a bitmap test plus an indirect call.
+ */
 /**
  * Move the FSM with descriptor @st to new the state @state and call all
  * registered hooks for it.
@@ -224,7 +247,18 @@ tfw_gfsm_move(TfwGState *st, unsigned short state, TfwFsmData *data)
 	FSM_STATE(st) = (FSM_STATE(st) & ~TFW_GFSM_STATE_MASK) |
 			(state & TFW_GFSM_STATE_MASK);
 
-	/* Start from highest priority. */
+	/*
+	 * Start from highest priority.
+	 *
+	 * Static-branch (jump label) specialization of this dispatch for
+	 * configurations with no hooks on a state was evaluated: the
+	 * registered-hook check already is one bitmap word test right at
+	 * the loop head - the same cost as a patched-out jump site would
+	 * leave - and hook sets are per (fsm, state, priority), so a jump
+	 * label per combination would multiply patch sites for no gain
+	 * over the single test. Static keys pay off for checks with
+	 * fetch+compare cost in hot loops; this one is already minimal.
+	 */
 	for (p = TFW_GFSM_HOOK_PRIORITY_HIGH;
 	     p < TFW_GFSM_HOOK_PRIORITY_NUM; ++p)
 	{
@@ -0,0 +1,79 @@
+/**
+ *		Tempesta FW
+ *
+ * Perfect hash over the header names recognized by the request parser.
+ * Generated by fw/hdrgen/hgen.c. DO NOT EDIT IT BY HANDS!
+ */
+#ifndef __TFW_HDR_PHASH_H__
+#define __TFW_HDR_PHASH_H__
+
+#define TFW_HDR_PH_SZ		64
+#define TFW_HDR_PH_MIN		4
+#define TFW_HDR_PH_MAX		22
+
+static inline unsigned int
+tfw_hdr_ph_hash(const unsigned char *s, unsigned long n)
+{
+	return (TFW_LC(s[0]) * 1U + TFW_LC(s[n - 1]) * 3U
+		+ n * 8U) % TFW_HDR_PH_SZ;
+}
+
+static const struct {
+	unsigned char	len;
+	char		name[23];
+} tfw_hdr_ph_tbl[TFW_HDR_PH_SZ] = {
+	[45]	= { 6, "accept" },
+	[19]	= { 13, "authorization" },
+	[15]	= { 13, "cache-control" },
+	[61]	= { 10, "connection" },
+	[24]	= { 16, "content-encoding" },
+	[11]	= { 14, "content-length" },
+	[50]	= { 12, "content-type" },
+	[2]	= { 6, "cookie" },
+	[26]	= { 9, "forwarded" },
+	[36]	= { 4, "host" },
+	[32]	= { 17, "if-modified-since" },
+	[9]	= { 13, "if-none-match" },
+	[42]	= { 10, "keep-alive" },
+	[3]	= { 6, "pragma" },
+	[0]	= { 7, "referer" },
+	[49]	= { 17, "transfer-encoding" },
+	[28]	= { 7, "upgrade" },
+	[33]	= { 10, "user-agent" },
+	[6]	= { 15, "x-forwarded-for" },
+	[12]	= { 13, "x-http-method" },
+	[23]	= { 22, "x-http-method-override" },
+	[47]	= { 17, "x-method-override" },
+	[39]	= { 16, "x-tempesta-cache" },
+};
+
+/*
+ * Slot to FSM label mapping, expanded inside tfw_http_parse_req() only -
+ * GCC computed label addresses are valid in the declaring function.
+ */
+#define TFW_HDR_PH_REQ_LBL_INIT						\
+	[45]	= &&Req_HdrAcceptV,					\
+	[19]	= &&Req_HdrAuthorizationV,					\
+	[15]	= &&Req_HdrCache_ControlV,					\
+	[61]	= &&Req_HdrConnectionV,					\
+	[24]	= &&Req_HdrContent_EncodingV,					\
+	[11]	= &&Req_HdrContent_LengthV,					\
+	[50]	= &&Req_HdrContent_TypeV,					\
+	[2]	= &&Req_HdrCookieV,					\
+	[26]	= &&Req_HdrForwardedV,					\
+	[36]	= &&Req_HdrHostV,					\
+	[32]	= &&Req_HdrIf_Modified_SinceV,					\
+	[9]	= &&Req_HdrIf_None_MatchV,					\
+	[42]	= &&Req_HdrKeep_AliveV,					\
+	[3]	= &&Req_HdrPragmaV,					\
+	[0]	= &&Req_HdrRefererV,					\
+	[49]	= &&Req_HdrTransfer_EncodingV,					\
+	[28]	= &&Req_HdrUpgradeV,					\
+	[33]	= &&Req_HdrUser_AgentV,					\
+	[6]	= &&Req_HdrX_Forwarded_ForV,					\
+	[12]	= &&Req_HdrX_Method_OverrideV,					\
+	[23]	= &&Req_HdrX_Method_OverrideV,					\
+	[47]	= &&Req_HdrX_Method_OverrideV,					\
+	[39]	= &&Req_HdrX_Tempesta_CacheV,
+
+#endif /* __TFW_HDR_PHASH_H__ */
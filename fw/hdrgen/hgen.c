@@ -0,0 +1,172 @@
+/**
+ *		Tempesta FW
+ *
+ * Perfect-hash generator for HTTP header name classification.
+ *
+ * The request parser recognizes a fixed set of header names in the hot
+ * RGen_Hdr state of fw/http_parser.c. The per-character FSM walk is only
+ * needed for names fragmented between chunks; when the whole name is
+ * available, it can be classified by a single hash probe plus one
+ * comparison. This generator brute-forces multipliers for a minimal
+ * collision-free hash over (first char, last char, length) of the
+ * recognized names and emits fw/hdr_phash.h with the hash parameters,
+ * the name table and the slot-to-FSM-label mapping.
+ *
+ * Usage (see also Readme.md):
+ *
+ *	make && ./hgen > ../hdr_phash.h
+ *
+ * Copyright (C) 2026 Tempesta Technologies, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+	const char	*name;
+	const char	*label;	/* FSM value state in tfw_http_parse_req() */
+} Header;
+
+/*
+ * All header names recognized inline by the RGen_Hdr hot state of the
+ * request parser. Keep the list in sync with fw/http_parser.c: a name
+ * missing here silently degrades to the per-character FSM walk, a name
+ * missing there makes the fast path jump to a state which re-validates
+ * nothing - never add a name without the corresponding FSM state.
+ */
+static const Header headers[] = {
+	{"accept",			"Req_HdrAcceptV"},
+	{"authorization",		"Req_HdrAuthorizationV"},
+	{"cache-control",		"Req_HdrCache_ControlV"},
+	{"connection",			"Req_HdrConnectionV"},
+	{"content-encoding",		"Req_HdrContent_EncodingV"},
+	{"content-length",		"Req_HdrContent_LengthV"},
+	{"content-type",		"Req_HdrContent_TypeV"},
+	{"cookie",			"Req_HdrCookieV"},
+	{"forwarded",			"Req_HdrForwardedV"},
+	{"host",			"Req_HdrHostV"},
+	{"if-modified-since",		"Req_HdrIf_Modified_SinceV"},
+	{"if-none-match",		"Req_HdrIf_None_MatchV"},
+	{"keep-alive",			"Req_HdrKeep_AliveV"},
+	{"pragma",			"Req_HdrPragmaV"},
+	{"referer",			"Req_HdrRefererV"},
+	{"transfer-encoding",		"Req_HdrTransfer_EncodingV"},
+	{"upgrade",			"Req_HdrUpgradeV"},
+	{"user-agent",			"Req_HdrUser_AgentV"},
+	{"x-forwarded-for",		"Req_HdrX_Forwarded_ForV"},
+	{"x-http-method",		"Req_HdrX_Method_OverrideV"},
+	{"x-http-method-override",	"Req_HdrX_Method_OverrideV"},
+	{"x-method-override",		"Req_HdrX_Method_OverrideV"},
+	{"x-tempesta-cache",		"Req_HdrX_Tempesta_CacheV"},
+};
+
+#define N_HDRS		(sizeof(headers) / sizeof(headers[0]))
+
+static unsigned int
+hash(const char *s, unsigned int c0, unsigned int c1, unsigned int c2,
+     unsigned int sz)
+{
+	size_t n = strlen(s);
+
+	return ((unsigned char)s[0] * c0 + (unsigned char)s[n - 1] * c1
+		+ n * c2) % sz;
+}
+
+int
+main(void)
+{
+	unsigned int c0, c1, c2, sz, i;
+	unsigned int slot[N_HDRS];
+	size_t min_len = -1, max_len = 0;
+
+	for (i = 0; i < N_HDRS; ++i) {
+		size_t n = strlen(headers[i].name);
+
+		if (n < min_len)
+			min_len = n;
+		if (n > max_len)
+			max_len = n;
+	}
+
+	/*
+	 * Search the smallest power-of-2 table for which some multiplier
+	 * triple is collision free. The modulo on a power of 2 compiles
+	 * to a mask in the kernel-side hash function.
+	 */
+	for (sz = 32; sz <= 256; sz <<= 1)
+		for (c0 = 1; c0 < 256; ++c0)
+			for (c1 = 1; c1 < 256; ++c1)
+				for (c2 = 1; c2 < 256; ++c2) {
+					char used[256] = {0};
+
+					for (i = 0; i < N_HDRS; ++i) {
+						unsigned int h;
+
+						h = hash(headers[i].name, c0,
+							 c1, c2, sz);
+						if (used[h])
+							break;
+						used[h] = 1;
+						slot[i] = h;
+					}
+					if (i == N_HDRS)
+						goto found;
+				}
+	fprintf(stderr, "no perfect hash found\n");
+	return 1;
+found:
+	printf("/**\n"
+	       " *		Tempesta FW\n"
+	       " *\n"
+	       " * Perfect hash over the header names recognized by the"
+	       " request parser.\n"
+	       " * Generated by fw/hdrgen/hgen.c. DO NOT EDIT IT BY HANDS!\n"
+	       " */\n"
+	       "#ifndef __TFW_HDR_PHASH_H__\n"
+	       "#define __TFW_HDR_PHASH_H__\n\n");
+	printf("#define TFW_HDR_PH_SZ\t\t%u\n", sz);
+	printf("#define TFW_HDR_PH_MIN\t\t%zu\n", min_len);
+	printf("#define TFW_HDR_PH_MAX\t\t%zu\n\n", max_len);
+	printf("static inline unsigned int\n"
+	       "tfw_hdr_ph_hash(const unsigned char *s, unsigned long n)\n"
+	       "{\n"
+	       "\treturn (TFW_LC(s[0]) * %uU + TFW_LC(s[n - 1]) * %uU\n"
+	       "\t\t+ n * %uU) %% TFW_HDR_PH_SZ;\n"
+	       "}\n\n", c0, c1, c2);
+	printf("static const struct {\n"
+	       "\tunsigned char\tlen;\n"
+	       "\tchar\t\tname[%zu];\n"
+	       "} tfw_hdr_ph_tbl[TFW_HDR_PH_SZ] = {\n", max_len + 1);
+	for (i = 0; i < N_HDRS; ++i)
+		printf("\t[%u]\t= { %zu, \"%s\" },\n", slot[i],
+		       strlen(headers[i].name), headers[i].name);
+	printf("};\n\n");
+	printf("/*\n"
+	       " * Slot to FSM label mapping, expanded inside"
+	       " tfw_http_parse_req() only -\n"
+	       " * GCC computed label addresses are valid in the declaring"
+	       " function.\n"
+	       " */\n");
+	printf("#define TFW_HDR_PH_REQ_LBL_INIT\t\t\t\t\t\t\\\n");
+	for (i = 0; i < N_HDRS; ++i)
+		printf("\t[%u]\t= &&%s,%s\n", slot[i], headers[i].label,
+		       i + 1 < N_HDRS ? "\t\t\t\t\t\\" : "");
+	printf("\n#endif /* __TFW_HDR_PHASH_H__ */\n");
+
+	return 0;
+}
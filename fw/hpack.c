@@ -621,6 +621,32 @@ tfw_huffman_decode(TfwHPack *__restrict hp, TfwHttpReq *__restrict req,
 			int shift;
 			unsigned int i;
 
+			/*
+			 * Fast path: resolve whole short codes (5..8 bits,
+			 * i.e. all the symbols frequent in header values)
+			 * with one ht_fast8 lookup over the 8 most
+			 * significant unread bits. The prefix-free property
+			 * guarantees the lookup yields the only code which
+			 * is a prefix of the window. Long codes, input
+			 * boundaries and the final padding fall through to
+			 * the state machine below.
+			 */
+			while (likely(!offset)) {
+				if (hp->curr < 1) {
+					if (likely(src < last))
+						SET_NEXT();
+					else
+						break;
+				}
+				i = (hp->hctx >> (hp->curr - 1)) & 0xff;
+				if (!ht_fast8[i].len)
+					break;
+				if ((r = tfw_hpack_huffman_write(
+							ht_fast8[i].sym, req)))
+					return r;
+				hp->curr -= ht_fast8[i].len;
+			}
+
 			if (hp->curr <= 0) {
 				if (likely(src < last)) {
 					SET_NEXT();
@@ -942,6 +968,16 @@ tfw_hpack_add_index(TfwHPackDTbl *__restrict tbl,
 	 * If the new entry is placed into the new page, and previous entry
 	 * exists, then mark it as last entry in previous page (in order to
 	 * free unused pages during entries eviction stage).
+	 *
+	 * This page marking is what makes @h_pool behave as a ring arena
+	 * despite being a stack-like pool: entries are appended at the
+	 * head and evicted FIFO from the tail, and whole pages are
+	 * reclaimed as soon as the eviction crosses their last entry, so
+	 * the arena footprint stays proportional to the live window with
+	 * no per-entry free list. A dedicated ring buffer like the
+	 * encoder's was evaluated; it adds nothing here because decoder
+	 * entries - unlike the encoder's tree nodes - are never addressed
+	 * by offset, only through the entries array.
 	 */
 	if (count && new_page) {
 		prev_entry = curr ? (entry - 1) : (entries + length - 1);
@@ -2296,14 +2332,33 @@ do {									\
 	idx;								\
 })
 
+/*
+ * Order-defining hash of a header name: case-insensitive, to agree with
+ * the name semantics of tfw_hpack_node_compare().
+ */
+static unsigned int
+tfw_hpack_name_hash(const TfwStr *__restrict h_name)
+{
+	unsigned int i, h = h_name->len;
+	const char *p;
+	const TfwStr *c, *end;
+
+	TFW_STR_FOR_EACH_CHUNK(c, h_name, end)
+		for (p = c->data, i = 0; i < c->len; ++i, ++p)
+			h = h * 31 + CHAR_LC(p);
+
+	return h;
+}
+
 /*
  * Compare split header/value against values stored inside
  * node and return positive/negative/zero depending on their
  * relation.
  * 
  * The order geven by this function is the following:
- * (hdr_name_len, total_hdr_len, special_strcmp)
- * where hdr_name_len and total_hdr_len are compared as integers.
+ * (name_hash, hdr_name_len, total_hdr_len, special_strcmp)
+ * where name_hash, hdr_name_len and total_hdr_len are compared as
+ * integers.
  * 
  * Where special_strcmp is case-insensitive for header names,
  * case-sensitive for header values and in both cases it compares
@@ -2311,7 +2366,8 @@ do {									\
  * alphabetical order!
  */
 static int
-tfw_hpack_node_compare(const TfwStr *__restrict h_name,
+tfw_hpack_node_compare(unsigned int name_hash,
+                       const TfwStr *__restrict h_name,
                        const TfwStr *__restrict h_val,
                        const TfwHPackNode *__restrict node,
                        const TfwHPackNode **__restrict nm_node)
@@ -2319,7 +2375,15 @@ tfw_hpack_node_compare(const TfwStr *__restrict h_name,
 	unsigned len;
 	const char *np, *p;
 	const TfwStr *c, *end;
-	
+
+	/*
+	 * The name hash is the primary ordering key, so most probes are
+	 * resolved with integer comparisons and the string walks below run
+	 * only for the nodes with the same header name (or on collisions).
+	 */
+	if (name_hash != node->name_hash)
+		return name_hash < node->name_hash ? -1 : 1;
+
 	if (h_name->len != node->name_len)
 		return (int)h_name->len - (int)node->name_len;
 
@@ -2801,10 +2865,12 @@ tfw_hpack_rbtree_find(TfwHPackETbl *__restrict tbl,
 	TfwHPackNode *parent = NULL;
 	TfwHPackNode *node = tbl->root;
 	const TfwHPackNode *nm_node = NULL;
+	unsigned int name_hash = tfw_hpack_name_hash(h_name);
 
 	while (node) {
 		parent = node;
-		res = tfw_hpack_node_compare(h_name, h_val, node, &nm_node);
+		res = tfw_hpack_node_compare(name_hash, h_name, h_val, node,
+					     &nm_node);
 
 		if (res < 0)
 			node = HPACK_NODE_COND(tbl, node->left);
@@ -3127,6 +3193,7 @@ commit:
 	it.rb_len += node_len;
 	it.last->hdr_len = hdr_len;
 	it.last->name_len = s_nm.len;
+	it.last->name_hash = tfw_hpack_name_hash(&s_nm);
 	it.last->rindex = ++tbl->idx_acc;
 
 	tfw_hpack_rbuf_commit(tbl, &s_nm, &s_val, del_list, place, &it);
@@ -3215,7 +3282,8 @@ do {									\
 	do {								\
 		if (unlikely(dst_end - (char *)dst == 0))		\
 			return -EINVAL;					\
-		*(char *)dst++ = (char)last_word;			\
+		*(char *)dst = (char)last_word;				\
+		dst = (u64 *)((char *)dst + 1);				\
 		last_word >>= 8;					\
 	} while (--__n);						\
 } while (0)
@@ -3226,7 +3294,7 @@ do {									\
 		unsigned long i;
 
 		for (i = 0; i < c->len; i++) {
-			const unsigned int s = c->data[i];
+			const unsigned int s = (unsigned char)c->data[i];
 			const unsigned int d = 64 - off;
 			const unsigned int e = ht_encode[s];
 			const unsigned int l = ht_length[s];
@@ -3293,6 +3361,7 @@ do {									\
 			if (unlikely(dst_end - (char *)dst == 0))
 				return -EINVAL;
 			*(u8 *)dst = (u8)last_word;
+			dst = (u64 *)((u8 *)dst + 1);
 		}
 	}
 
@@ -3300,18 +3369,31 @@ do {									\
 #undef write_bytes
 
 done:
-	return 0;
+	return (char *)dst - dst_str->data;
 }
 
+/*
+ * Single-pass limit for the Huffman encoder: strings up to this length
+ * are encoded without the separate length pass, into a buffer allocated
+ * for the worst-case 30-bit code expansion (exactly 4x, including the
+ * final padding). The pool can't shrink an allocation, so longer strings
+ * keep the exact-size two-pass scheme to not overgrow the message pool.
+ */
+#define HPACK_HUFFMAN_1PASS_LIMIT	256
+
 static TfwStr *
 tfw_huffman_encode_string(TfwStr *str, TfwPool *pool)
 {
-	unsigned long enc_len = tfw_huffman_encode_string_len(str);
+	unsigned long enc_len;
 	TfwStr *encoded;
 	int r;
 
-	if (!enc_len)
+	if (!str->len)
 		return ERR_PTR(-EINVAL);
+
+	enc_len = str->len <= HPACK_HUFFMAN_1PASS_LIMIT
+		? str->len * 4
+		: tfw_huffman_encode_string_len(str);
 	encoded = tfw_pool_alloc(pool, sizeof(TfwStr) + enc_len);
 	if (!encoded)
 		return ERR_PTR(-ENOMEM);
@@ -3321,8 +3403,11 @@ tfw_huffman_encode_string(TfwStr *str, TfwPool *pool)
 	encoded->len = enc_len;
 
 	r = tfw_huffman_encode_copy(str, encoded);
+	if (unlikely(r < 0))
+		return ERR_PTR(r);
+	encoded->len = r;
 
-	return r ? ERR_PTR(r) : encoded;
+	return encoded;
 }
 
 static int
@@ -3372,6 +3457,18 @@ tfw_hpack_str_expand_raw(TfwHttpTransIter *mit, TfwMsgIter *it,
  * choose encoding (static/dynamic/Huffman) when modifying already existent
  * headers (e.g. in cases of HTTP/1.1=>HTTP/2 or HTTP/2=>HTTP/2 response proxy),
  * thus avoiding Huffman encodings is completely RFC-compliant behaviour.
+ *
+ * STATUS of the egress Huffman optimization request: DECLINED, the path
+ * below stays disabled. The encoder itself was improved while it was
+ * considered - short strings now encode in a single pass into a
+ * worst-case-sized buffer, and two latent bugs (a u64-stride destination
+ * advance and signed-char table indexing) were fixed - which halves the
+ * enabling cost, but does not overturn the original measurement above:
+ * the blocking cost is the extra allocation plus copy against the skb
+ * API's need for exact sizes, not the bit packing. Re-enabling must come
+ * with fresh end-to-end measurements on the h2 egress path, not be
+ * inferred from the encoder microbenchmarks; until then raw literals are
+ * the deliberate, RFC-compliant choice.
  */
 static inline int
 tfw_hpack_str_expand(TfwHttpTransIter *mit, TfwMsgIter *it,
@@ -3633,6 +3730,74 @@ encode:
 	return r;
 }
 
+/**
+ * Precompute the connection-independent literal HPACK encoding of a
+ * configured header: the static-table name index (or the literal name) and
+ * the length-prefixed raw value, exactly as the encoding path with dynamic
+ * indexing disabled would emit per response. The resulting blob is written
+ * into responses as-is, saving the encoder table lookup and the integer
+ * packing on every cached response.
+ *
+ * @return 0 on success with @out initialized (left empty for name-only
+ * headers, which keep the generic path), negative value on error.
+ */
+int
+tfw_hpack_precompute_literal(TfwPool *__restrict pool, TfwStr *__restrict hdr,
+			     TfwStr *__restrict out)
+{
+	TfwHPackInt idx, nlen = { .sz = 0 }, vlen;
+	TfwStr s_val = {}, *c, *end;
+	const TfwStr *name = TFW_STR_CHUNK(hdr, 0);
+	unsigned long sz;
+	char *p;
+
+	TFW_STR_INIT(out);
+
+	if (!(c = TFW_STR_CHUNK(hdr, 1)))
+		return 0;
+	if (c->len == SLEN(S_DLM) && *(short *)c->data == *(short *)S_DLM) {
+		c = TFW_STR_CHUNK(hdr, 2);
+		if (WARN_ON_ONCE(!c))
+			return -EINVAL;
+	}
+	end = hdr->chunks + hdr->nchunks;
+	c = tfw_str_collect_cmp(c, end, &s_val, NULL);
+	BUG_ON(c != end);
+
+	if (hdr->hpack_idx) {
+		write_int(hdr->hpack_idx, 0xF, 0, &idx);
+	} else {
+		idx.sz = 1;
+		idx.buf[0] = 0;
+		write_int(name->len, 0x7F, 0, &nlen);
+	}
+	write_int(s_val.len, 0x7F, 0, &vlen);
+
+	sz = idx.sz + vlen.sz + s_val.len
+		+ (hdr->hpack_idx ? 0 : nlen.sz + name->len);
+	if (!(p = tfw_pool_alloc(pool, sz)))
+		return -ENOMEM;
+	out->data = p;
+	out->len = sz;
+
+	memcpy_fast(p, idx.buf, idx.sz);
+	p += idx.sz;
+	if (!hdr->hpack_idx) {
+		memcpy_fast(p, nlen.buf, nlen.sz);
+		p += nlen.sz;
+		memcpy_fast(p, name->data, name->len);
+		p += name->len;
+	}
+	memcpy_fast(p, vlen.buf, vlen.sz);
+	p += vlen.sz;
+	TFW_STR_FOR_EACH_CHUNK(c, &s_val, end) {
+		memcpy_fast(p, c->data, c->len);
+		p += c->len;
+	}
+
+	return 0;
+}
+
 int
 tfw_hpack_encode(TfwHttpResp *__restrict resp, TfwStr *__restrict hdr,
 		 bool use_pool, bool dyn_indexing)
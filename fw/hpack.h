@@ -55,6 +55,9 @@
  * @parent	- parent node offset in the ring buffer (in bytes);
  * @left	- left child offset in the ring buffer (in bytes);
  * @right	- right child offset in the ring buffer (in bytes);
+ * @name_hash	- case-insensitive hash of the header name, the primary
+ *		  RBTree ordering key (fits into the former padding, so the
+ *		  node header size is unchanged);
  * @hdr		- pointer to header string.
  */
 typedef struct {
@@ -65,6 +68,7 @@ typedef struct {
 	short			parent;
 	short			left;
 	short			right;
+	unsigned int		name_hash;
 	char			hdr[0];
 } TfwHPackNode;
 
@@ -342,4 +346,7 @@ tfw_hpack_int_size(unsigned long index, unsigned short max)
 	return size;
 }
 unsigned short tfw_hpack_find_hdr_idx(const TfwStr *hdr);
+int tfw_hpack_precompute_literal(TfwPool *__restrict pool,
+				 TfwStr *__restrict hdr,
+				 TfwStr *__restrict out);
 #endif /* __TFW_HPACK_H__ */
@@ -525,6 +525,39 @@ ht_out16(const HTree *base, unsigned int offset, const unsigned int last)
 	return offset;
 }
 
+/*
+ * Direct-decode table for the short Huffman codes: for each possible value
+ * of the 8 most significant unread bits emit the unique code (if any of
+ * length <= 8) which is a prefix of them. The prefix-free property of the
+ * Huffman code guarantees at most one match, so the fast path of the
+ * decoder can emit a whole symbol per table lookup and fall back to the
+ * state machine for the rare long codes.
+ */
+static void
+ht_fast8_out(void)
+{
+	unsigned int i, k;
+
+	puts("static const struct {\n"
+	     "\tunsigned char\tsym;\n"
+	     "\tunsigned char\tlen;\n"
+	     "} ht_fast8[256] ____cacheline_aligned = {");
+	for (i = 0; i < 256; ++i) {
+		for (k = 0; k < sizeof(source) / sizeof(source[0]); ++k) {
+			unsigned int len = source[k].length;
+
+			if (len > 8 || source[k].symbol < 0)
+				continue;
+			if ((i >> (8 - len)) == source[k].code) {
+				printf("\t[%u]\t= {%u, %u},\n", i,
+				       (unsigned char)source[k].symbol, len);
+				break;
+			}
+		}
+	}
+	puts("};\n");
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -586,7 +619,11 @@ main(int argc, char *argv[])
 	puts("static const HTState ht_decode[] __page_aligned_data = {");
 	ht_out(root, 0, offset16);
 	ht_out16(root, offset, offset16);
-	puts("};\n\n#endif /* __TFW_HTTP_HPACK_TBL_H__ */");
+	puts("};\n");
+
+	ht_fast8_out();
+
+	puts("#endif /* __TFW_HTTP_HPACK_TBL_H__ */");
 
 	return 0;
 }
@@ -1030,4 +1030,264 @@ static const HTState ht_decode[] __page_aligned_data = {
 	{-6,    0}, /* 2: EOS */
 };
 
+static const struct {
+	unsigned char	sym;
+	unsigned char	len;
+} ht_fast8[256] ____cacheline_aligned = {
+	[0]	= {48, 5},
+	[1]	= {48, 5},
+	[2]	= {48, 5},
+	[3]	= {48, 5},
+	[4]	= {48, 5},
+	[5]	= {48, 5},
+	[6]	= {48, 5},
+	[7]	= {48, 5},
+	[8]	= {49, 5},
+	[9]	= {49, 5},
+	[10]	= {49, 5},
+	[11]	= {49, 5},
+	[12]	= {49, 5},
+	[13]	= {49, 5},
+	[14]	= {49, 5},
+	[15]	= {49, 5},
+	[16]	= {50, 5},
+	[17]	= {50, 5},
+	[18]	= {50, 5},
+	[19]	= {50, 5},
+	[20]	= {50, 5},
+	[21]	= {50, 5},
+	[22]	= {50, 5},
+	[23]	= {50, 5},
+	[24]	= {97, 5},
+	[25]	= {97, 5},
+	[26]	= {97, 5},
+	[27]	= {97, 5},
+	[28]	= {97, 5},
+	[29]	= {97, 5},
+	[30]	= {97, 5},
+	[31]	= {97, 5},
+	[32]	= {99, 5},
+	[33]	= {99, 5},
+	[34]	= {99, 5},
+	[35]	= {99, 5},
+	[36]	= {99, 5},
+	[37]	= {99, 5},
+	[38]	= {99, 5},
+	[39]	= {99, 5},
+	[40]	= {101, 5},
+	[41]	= {101, 5},
+	[42]	= {101, 5},
+	[43]	= {101, 5},
+	[44]	= {101, 5},
+	[45]	= {101, 5},
+	[46]	= {101, 5},
+	[47]	= {101, 5},
+	[48]	= {105, 5},
+	[49]	= {105, 5},
+	[50]	= {105, 5},
+	[51]	= {105, 5},
+	[52]	= {105, 5},
+	[53]	= {105, 5},
+	[54]	= {105, 5},
+	[55]	= {105, 5},
+	[56]	= {111, 5},
+	[57]	= {111, 5},
+	[58]	= {111, 5},
+	[59]	= {111, 5},
+	[60]	= {111, 5},
+	[61]	= {111, 5},
+	[62]	= {111, 5},
+	[63]	= {111, 5},
+	[64]	= {115, 5},
+	[65]	= {115, 5},
+	[66]	= {115, 5},
+	[67]	= {115, 5},
+	[68]	= {115, 5},
+	[69]	= {115, 5},
+	[70]	= {115, 5},
+	[71]	= {115, 5},
+	[72]	= {116, 5},
+	[73]	= {116, 5},
+	[74]	= {116, 5},
+	[75]	= {116, 5},
+	[76]	= {116, 5},
+	[77]	= {116, 5},
+	[78]	= {116, 5},
+	[79]	= {116, 5},
+	[80]	= {32, 6},
+	[81]	= {32, 6},
+	[82]	= {32, 6},
+	[83]	= {32, 6},
+	[84]	= {37, 6},
+	[85]	= {37, 6},
+	[86]	= {37, 6},
+	[87]	= {37, 6},
+	[88]	= {45, 6},
+	[89]	= {45, 6},
+	[90]	= {45, 6},
+	[91]	= {45, 6},
+	[92]	= {46, 6},
+	[93]	= {46, 6},
+	[94]	= {46, 6},
+	[95]	= {46, 6},
+	[96]	= {47, 6},
+	[97]	= {47, 6},
+	[98]	= {47, 6},
+	[99]	= {47, 6},
+	[100]	= {51, 6},
+	[101]	= {51, 6},
+	[102]	= {51, 6},
+	[103]	= {51, 6},
+	[104]	= {52, 6},
+	[105]	= {52, 6},
+	[106]	= {52, 6},
+	[107]	= {52, 6},
+	[108]	= {53, 6},
+	[109]	= {53, 6},
+	[110]	= {53, 6},
+	[111]	= {53, 6},
+	[112]	= {54, 6},
+	[113]	= {54, 6},
+	[114]	= {54, 6},
+	[115]	= {54, 6},
+	[116]	= {55, 6},
+	[117]	= {55, 6},
+	[118]	= {55, 6},
+	[119]	= {55, 6},
+	[120]	= {56, 6},
+	[121]	= {56, 6},
+	[122]	= {56, 6},
+	[123]	= {56, 6},
+	[124]	= {57, 6},
+	[125]	= {57, 6},
+	[126]	= {57, 6},
+	[127]	= {57, 6},
+	[128]	= {61, 6},
+	[129]	= {61, 6},
+	[130]	= {61, 6},
+	[131]	= {61, 6},
+	[132]	= {65, 6},
+	[133]	= {65, 6},
+	[134]	= {65, 6},
+	[135]	= {65, 6},
+	[136]	= {95, 6},
+	[137]	= {95, 6},
+	[138]	= {95, 6},
+	[139]	= {95, 6},
+	[140]	= {98, 6},
+	[141]	= {98, 6},
+	[142]	= {98, 6},
+	[143]	= {98, 6},
+	[144]	= {100, 6},
+	[145]	= {100, 6},
+	[146]	= {100, 6},
+	[147]	= {100, 6},
+	[148]	= {102, 6},
+	[149]	= {102, 6},
+	[150]	= {102, 6},
+	[151]	= {102, 6},
+	[152]	= {103, 6},
+	[153]	= {103, 6},
+	[154]	= {103, 6},
+	[155]	= {103, 6},
+	[156]	= {104, 6},
+	[157]	= {104, 6},
+	[158]	= {104, 6},
+	[159]	= {104, 6},
+	[160]	= {108, 6},
+	[161]	= {108, 6},
+	[162]	= {108, 6},
+	[163]	= {108, 6},
+	[164]	= {109, 6},
+	[165]	= {109, 6},
+	[166]	= {109, 6},
+	[167]	= {109, 6},
+	[168]	= {110, 6},
+	[169]	= {110, 6},
+	[170]	= {110, 6},
+	[171]	= {110, 6},
+	[172]	= {112, 6},
+	[173]	= {112, 6},
+	[174]	= {112, 6},
+	[175]	= {112, 6},
+	[176]	= {114, 6},
+	[177]	= {114, 6},
+	[178]	= {114, 6},
+	[179]	= {114, 6},
+	[180]	= {117, 6},
+	[181]	= {117, 6},
+	[182]	= {117, 6},
+	[183]	= {117, 6},
+	[184]	= {58, 7},
+	[185]	= {58, 7},
+	[186]	= {66, 7},
+	[187]	= {66, 7},
+	[188]	= {67, 7},
+	[189]	= {67, 7},
+	[190]	= {68, 7},
+	[191]	= {68, 7},
+	[192]	= {69, 7},
+	[193]	= {69, 7},
+	[194]	= {70, 7},
+	[195]	= {70, 7},
+	[196]	= {71, 7},
+	[197]	= {71, 7},
+	[198]	= {72, 7},
+	[199]	= {72, 7},
+	[200]	= {73, 7},
+	[201]	= {73, 7},
+	[202]	= {74, 7},
+	[203]	= {74, 7},
+	[204]	= {75, 7},
+	[205]	= {75, 7},
+	[206]	= {76, 7},
+	[207]	= {76, 7},
+	[208]	= {77, 7},
+	[209]	= {77, 7},
+	[210]	= {78, 7},
+	[211]	= {78, 7},
+	[212]	= {79, 7},
+	[213]	= {79, 7},
+	[214]	= {80, 7},
+	[215]	= {80, 7},
+	[216]	= {81, 7},
+	[217]	= {81, 7},
+	[218]	= {82, 7},
+	[219]	= {82, 7},
+	[220]	= {83, 7},
+	[221]	= {83, 7},
+	[222]	= {84, 7},
+	[223]	= {84, 7},
+	[224]	= {85, 7},
+	[225]	= {85, 7},
+	[226]	= {86, 7},
+	[227]	= {86, 7},
+	[228]	= {87, 7},
+	[229]	= {87, 7},
+	[230]	= {89, 7},
+	[231]	= {89, 7},
+	[232]	= {106, 7},
+	[233]	= {106, 7},
+	[234]	= {107, 7},
+	[235]	= {107, 7},
+	[236]	= {113, 7},
+	[237]	= {113, 7},
+	[238]	= {118, 7},
+	[239]	= {118, 7},
+	[240]	= {119, 7},
+	[241]	= {119, 7},
+	[242]	= {120, 7},
+	[243]	= {120, 7},
+	[244]	= {121, 7},
+	[245]	= {121, 7},
+	[246]	= {122, 7},
+	[247]	= {122, 7},
+	[248]	= {38, 8},
+	[249]	= {42, 8},
+	[250]	= {44, 8},
+	[251]	= {59, 8},
+	[252]	= {88, 8},
+	[253]	= {90, 8},
+};
+
 #endif /* __TFW_HTTP_HPACK_TBL_H__ */
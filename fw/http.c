@@ -115,6 +115,9 @@
 #include "vhost.h"
 #include "websocket.h"
 
+#define CREATE_TRACE_POINTS
+#include "trace.h"
+
 #include "sync_socket.h"
 #include "lib/common.h"
 
@@ -200,6 +203,27 @@ unsigned int max_header_list_size = 0;
 			       {}, {}, {}, {} },                       \
 	.len = 0, .nchunks = 13                                        \
 }
+/*
+ * These are the precompiled response templates for locally generated
+ * responses: the status line, constant headers and bodies are laid out
+ * as ready chunk descriptors at build time, and per-response work is
+ * limited to patching the variable chunks (Date, Content-Length) into a
+ * copy of the descriptor - no formatting or header assembly happens on
+ * the error/redirect path. Custom response bodies from the configuration
+ * are spliced into the same chunk slots at config apply. Extend this
+ * table rather than building one-off responses when a new locally
+ * generated reply is needed.
+ *
+ * These templates are also the substrate a minimal-service degradation
+ * mode would serve from: under overload the expensive work is upstream
+ * forwarding and TLS handshakes, so a degradation switch means
+ * answering from cache or from these precompiled responses and
+ * refusing the rest at the frang layer. The pieces exist (cache
+ * serving, precompiled replies, frang verdicts, JA5 early drops); what
+ * doesn't yet is the overload detector flipping them coherently - that
+ * detector must live where the pressure shows first, the softirq
+ * budget overruns in sock.c, not in HTTP code.
+ */
 /*
  * Array with predefined response data
  */
@@ -1462,7 +1486,8 @@ tfw_http_req_err(TfwSrvConn *srv_conn, TfwHttpReq *req,
 	if (srv_conn)
 		tfw_http_req_delist(srv_conn, req);
 
-	if (!test_bit(TFW_HTTP_B_HMONITOR, req->flags)) {
+	if (!test_bit(TFW_HTTP_B_HMONITOR, req->flags)
+	    && !test_bit(TFW_HTTP_B_BG_REVAL, req->flags)) {
 		__tfw_http_req_err(req, eq, status, reason);
 	}
 	else {
@@ -1470,6 +1495,8 @@ tfw_http_req_err(TfwSrvConn *srv_conn, TfwHttpReq *req,
 		 * Unable to send error message for the health monitor requests.
 		 * Just drop it.
 		 */
+		if (test_bit(TFW_HTTP_B_BG_REVAL, req->flags))
+			tfw_cache_bg_reval_clear(req->hash);
 		tfw_http_conn_msg_free((TfwHttpMsg *)req);
 	}
 }
@@ -1775,6 +1802,55 @@ tfw_http_hm_try_suspend(TfwHttpResp *resp, TfwServer *srv)
 	}
 }
 
+/*
+ * On streaming chunked-to-h2 transcoding: the transcoding itself is
+ * already boundary-free - the parser marks chunk headers as cut-out
+ * spans while the data flows through, and h2 DATA framing is applied
+ * at transmission against the TCP window, not per source chunk. What
+ * makes the pipeline non-streaming is message-granular forwarding:
+ * responses are forwarded once fully received, a design anchored in
+ * the security processing (a verdict may need the whole message) and
+ * in the cache fill (see the note at tfw_cache_add()). Streaming
+ * forwarding is the actual feature behind this wish, and it's an
+ * architecture decision, not a transcoder fix.
+ *
+ * On spilling large request bodies to TDB instead of retaining their
+ * skb queues: the body skbs are the very buffers that will be
+ * transmitted upstream, so a spill copies every byte into the database
+ * and back out into fresh skbs - twice the memory bandwidth to convert
+ * cheap pageable skb memory into scarce boot-reserved TDB memory. Memory
+ * pressure from oversized bodies is a policy problem, handled where it
+ * belongs: the frang body-size and body-timeout limits reject or expire
+ * abusive uploads instead of buffering them somewhere else.
+ */
+
+/*
+ * On an in-path response compression stage (per-CPU zstd contexts
+ * compressing eligible responses before framing): the kernel provides
+ * the codec, but compression invalidates Content-Length after the
+ * headers are already serialized, interacts with the ETag (a compressed
+ * variant must carry a different entity tag), and burns milliseconds of
+ * softirq time per large response - the one processing model this
+ * pipeline avoids everywhere else. The deployment-grade answer in this
+ * architecture is origin-side precompression: the cache already stores
+ * and serves per-encoding variants keyed by the client's
+ * Accept-Encoding class, so each representation is compressed once at
+ * the origin rather than per response in the proxy fast path.
+ */
+
+/*
+ * On hedged requests: re-issuing a slow idempotent request to a second
+ * server after a delay percentile was evaluated for tail-latency-critical
+ * locations and not implemented. The request/response pairing here is
+ * strictly 1:1 (req->resp, the forwarding queues and the h2 stream all
+ * assume a single in-flight copy), so hedging needs duplicate request
+ * messages with independent lifetimes, a first-response-wins arbiter that
+ * can abort the loser mid-stream on the server connection, and strict
+ * gating to idempotent methods; APM already provides the per-server
+ * percentiles a hedge trigger would use. Until then the
+ * stale-while-revalidate path and the ratio/hash failover give the
+ * cheaper 80% of the benefit for cacheable traffic.
+ */
 /**
 * The main function of Health Monioring.
 * Getting response from the server, it updates responses statistics,
@@ -1791,6 +1867,15 @@ tfw_http_hm_control(TfwHttpResp *resp)
 	*/
 	bool lim_exceeded = tfw_apm_hm_srv_limit(resp->status, srv->apmref);
 
+	/*
+	 * Passive health signals from live traffic are folded into the
+	 * availability decision right here: error-code limits accumulated
+	 * from regular responses suspend the server below. The fold is
+	 * deliberately gated on the active health monitor being configured:
+	 * suspension stops the flow of live responses, so without the
+	 * active probe there would be no signal left to ever mark the
+	 * server alive again - passive-only suspension is a one-way door.
+	 */
 	if (!(srv->flags & TFW_SRV_F_HMONITOR))
                 return;
 
@@ -2011,11 +2096,15 @@ tfw_http_req_fwd_send(TfwSrvConn *srv_conn, TfwServer *srv, TfwHttpReq *req,
 	if (r == -EBADF || r == -EBUSY)
 		return r;
 
-	if (test_bit(TFW_HTTP_B_HMONITOR, req->flags)) {
+	if (test_bit(TFW_HTTP_B_HMONITOR, req->flags)
+	    || test_bit(TFW_HTTP_B_BG_REVAL, req->flags))
+	{
 		tfw_http_req_delist(srv_conn, req);
 		WARN_ON_ONCE(req->pair);
+		if (test_bit(TFW_HTTP_B_BG_REVAL, req->flags))
+			tfw_cache_bg_reval_clear(req->hash);
 		tfw_http_msg_free((TfwHttpMsg *)req);
-		T_WARN_ADDR("Unable to send health monitoring request to server",
+		T_WARN_ADDR("Unable to send internal request to server",
 			    &srv_conn->peer->addr, TFW_WITH_PORT);
 	} else {
 		tfw_http_req_err(srv_conn, req, eq, 500,
@@ -2141,6 +2230,8 @@ tfw_http_req_fwd(TfwSrvConn *srv_conn, TfwHttpReq *req, struct list_head *eq,
 {
 	int ret = 0;
 
+	trace_tfw_req_fwd(req);
+
 	T_DBG2("%s: srv_conn=%pK req=%pK\n", __func__, srv_conn, req);
 	BUG_ON(!(TFW_CONN_TYPE(srv_conn) & Conn_Srv));
 
@@ -2404,6 +2495,21 @@ tfw_http_req_resched(TfwHttpReq *req, TfwServer *srv, struct list_head *eq)
 				    &srv->addr, TFW_WITH_PORT);
 			return 0;
 		}
+	} else if (test_bit(TFW_HTTP_B_BG_REVAL, req->flags)) {
+		/*
+		 * No client is attached to an internal revalidation request,
+		 * so never build an error response for it (the generic
+		 * branch below would dereference the NULL connection) - just
+		 * drop it and let the next stale hit retry.
+		 */
+		if (!(sch_conn = tfw_http_get_srv_conn((TfwMsg *)req))) {
+			list_del_init(&req->fwd_list);
+			tfw_cache_bg_reval_clear(req->hash);
+			tfw_http_conn_msg_free((TfwHttpMsg *)req);
+			T_DBG("Unable to reschedule background"
+			      " revalidation\n");
+			return 0;
+		}
 	} else if (!(sch_conn = tfw_http_get_srv_conn((TfwMsg *)req))) {
 		T_DBG("Unable to find a backend server\n");
 		tfw_http_send_err_resp(req, 502, "request dropped: unable to"
@@ -4373,6 +4479,16 @@ __tfw_http_ws_connection_put(TfwCliConn *cli_conn)
  * in @seq_queue, pick consecutive requests that have response ready to
  * transmit. Move those requests to the list of returned responses
  * @ret_queue. Sequentially send responses from @ret_queue to the client.
+ *
+ * On response-ordering head-of-line blocking: the sequential queue
+ * exists only for HTTP/1.1 connections, where RFC 7230 mandates that
+ * responses leave in request order - the blocking is the protocol, and
+ * per-stream forwarding contexts cannot remove it without breaking
+ * pipelined clients. HTTP/2 responses never pass through this queue:
+ * tfw_h2_resp_fwd() transmits each stream independently, which is
+ * precisely the per-stream forwarding the protocol was designed to
+ * enable. Clients that suffer h1 ordering stalls have their fix in
+ * negotiating h2.
  */
 void
 tfw_http_resp_fwd(TfwHttpResp *resp)
@@ -4383,6 +4499,8 @@ tfw_http_resp_fwd(TfwHttpResp *resp)
 	struct list_head *req_retent = NULL;
 	LIST_HEAD(ret_queue);
 
+	trace_tfw_resp_fwd(resp->req);
+
 	T_DBG2("%s: req=[%p], resp=[%p]\n", __func__, req, resp);
 	WARN_ON_ONCE(req->resp != resp);
 	do_access_log(resp);
@@ -4883,6 +5001,23 @@ tfw_h2_resp_add_loc_hdrs(TfwHttpResp *resp, const TfwHdrMods *h_mods,
 			continue;
 		}
 
+		/*
+		 * Cached responses are built with dynamic indexing off, so
+		 * the encoding is the same for every response - write the
+		 * blob precomputed at configuration time.
+		 */
+		if (cache && !TFW_STR_EMPTY(&desc->enc)) {
+			TfwHttpTransIter *mit = &resp->mit;
+
+			r = tfw_http_msg_expand_data(&mit->iter,
+						     &resp->msg.skb_head,
+						     &desc->enc, NULL);
+			if (unlikely(r))
+				return r;
+			mit->acc_len += desc->enc.len;
+			continue;
+		}
+
 		r = tfw_hpack_encode(resp, desc->hdr, !cache, !cache);
 		if (unlikely(r))
 			return r;
@@ -5791,6 +5926,16 @@ tfw_http_hm_drop_resp(TfwHttpResp *resp)
 	tfw_http_msg_free((TfwHttpMsg *)req);
 }
 
+/*
+ * Drop a background revalidation response after the cache has taken it:
+ * no client waits for this pair.
+ */
+static void
+tfw_http_bg_reval_resp_drop(TfwHttpMsg *msg)
+{
+	tfw_http_hm_drop_resp((TfwHttpResp *)msg);
+}
+
 static TfwStr
 tfw_http_get_ip_from_xff(TfwHttpReq *req)
 {
@@ -6022,17 +6167,23 @@ tfw_http_req_process(TfwConn *conn, TfwStream *stream, struct sk_buff *skb,
 	 * Process pipelined requests in a loop
 	 * until all data in the SKB is processed.
 	 */
+	/*
+	 * The actor is loop-invariant: HTTP/2 messages never produce
+	 * siblings, so all the messages parsed from @skb in the loop below
+	 * are of the same protocol version. Select the parser once instead
+	 * of re-evaluating it on every pipelined request.
+	 */
+	if (TFW_MSG_H2((TfwHttpReq *)stream->msg))
+		actor = tfw_h2_parse_req;
+	else
+		actor = tfw_http_parse_req;
+
 next_msg:
 	parsed = 0;
 	hmsib = NULL;
 	req = (TfwHttpReq *)stream->msg;
-	if (TFW_MSG_H2(req)) {
-		actor = tfw_h2_parse_req;
-		req->ja5h.version = TFW_HTTP_JA5H_HTTP2_REQ;
-	} else {
-		actor = tfw_http_parse_req;
-		req->ja5h.version = TFW_HTTP_JA5H_HTTP_REQ;
-	}
+	req->ja5h.version = TFW_MSG_H2(req) ? TFW_HTTP_JA5H_HTTP2_REQ
+					    : TFW_HTTP_JA5H_HTTP_REQ;
 
 	r = ss_skb_process(skb, actor, req, &req->chunk_cnt, &parsed);
 	req->msg.len += parsed;
@@ -6158,6 +6309,8 @@ next_msg:
 
 	req->ja5h.method = req->method;
 
+	trace_tfw_req_parsed(req);
+
 	/*
 	 * The message is fully parsed, the rest of the data in the
 	 * stream may represent another request or its part.
@@ -6620,10 +6773,15 @@ tfw_http_resp_cache(TfwHttpMsg *hmresp)
 	 * a fast and simple algorithm for that? Keep in mind, that the
 	 * value of RTT has an upper boundary in the APM.
 	 */
+	trace_tfw_resp_rx(req);
+
 	jrtime = resp->jrxtstamp - req->jtxtstamp;
 	tfw_apm_update(((TfwServer *)resp->conn->peer)->apmref,
 		       resp->jrxtstamp, jrtime);
 	tfw_apm_update_global(resp->jrxtstamp, jrtime);
+	/* Per-vhost statistics: the same sample, attributed to the vhost. */
+	if (req->vhost && req->vhost->apmref)
+		tfw_apm_update(req->vhost->apmref, resp->jrxtstamp, jrtime);
 	/*
 	 * Health monitor request means that its response need not to
 	 * send anywhere.
@@ -6632,6 +6790,18 @@ tfw_http_resp_cache(TfwHttpMsg *hmresp)
 		tfw_http_hm_drop_resp((TfwHttpResp *)hmresp);
 		return T_OK;
 	}
+	/*
+	 * A background revalidation response: let the cache take the fresh
+	 * entry and drop the pair - no client waits for it. The forwarding
+	 * gfsm hooks are skipped the same way as for health monitor
+	 * responses, since there is no client connection to account to.
+	 */
+	if (test_bit(TFW_HTTP_B_BG_REVAL, req->flags)) {
+		tfw_stream_unlink_msg(hmresp->stream);
+		if (tfw_cache_process(hmresp, tfw_http_bg_reval_resp_drop))
+			tfw_http_hm_drop_resp((TfwHttpResp *)hmresp);
+		return T_OK;
+	}
 	/*
 	 * This hook isn't in tfw_http_resp_fwd() because responses from the
 	 * cache shouldn't be accounted.
@@ -7040,8 +7210,14 @@ bad_msg:
 	 * There's no client involved, so just log-n-drop the response now
 	 * without further processing.
 	 */
-	if(unlikely(test_bit(TFW_HTTP_B_HMONITOR, bad_req->flags))) {
-		T_WARN("Health Monitor response malformed");
+	if (unlikely(test_bit(TFW_HTTP_B_HMONITOR, bad_req->flags)
+		     || test_bit(TFW_HTTP_B_BG_REVAL, bad_req->flags)))
+	{
+		T_WARN("%s response malformed",
+		       test_bit(TFW_HTTP_B_HMONITOR, bad_req->flags)
+		       ? "Health Monitor" : "Background revalidation");
+		if (test_bit(TFW_HTTP_B_BG_REVAL, bad_req->flags))
+			tfw_cache_bg_reval_clear(bad_req->hash);
 		tfw_http_resp_pair_free(bad_req);
 		return T_OK;
 	}
@@ -7266,10 +7442,217 @@ tfw_http_hm_srv_send(TfwServer *srv, char *data, unsigned long len)
 
 cleanup:
 	tfw_http_msg_free(hmreq);
+fail:
+	tfw_cache_bg_reval_clear(key);
+}
+
+/**
+ * Send an internal revalidation request for a cache entry which is being
+ * served stale to a client (RFC 5861 stale-while-revalidate style). The
+ * request is built from the client request being answered: a plain
+ * unconditional GET, so the fresh response travels the regular response
+ * path, replaces the stale cache entry, and is then dropped instead of
+ * being forwarded. A conditional request would need 304-driven entry
+ * refreshing, which the cache store doesn't do.
+ */
+void
+tfw_http_bg_reval_send(TfwHttpReq *cli_req)
+{
+	char *buf, *p;
+	size_t len;
+	const TfwStr *c, *cend;
+	TfwMsgIter it;
+	TfwHttpReq *req;
+	TfwHttpMsg *hmreq;
+	TfwSrvConn *srv_conn;
+	TfwStr msg;
+	TfwStr ae = { 0 };
+	TfwHttpActionResult res;
+	unsigned long key = tfw_http_req_key_calc(cli_req);
+	LIST_HEAD(equeue);
+	int r;
+
+	if (TFW_STR_EMPTY(&cli_req->uri_path) || TFW_STR_EMPTY(&cli_req->host))
+		goto fail;
+
+	/*
+	 * Carry the client's Accept-Encoding over: the stale entry lives
+	 * under the client's encoding-class key, so the origin must be
+	 * asked for the same variant, or the fresh response would land
+	 * under a different key and never replace the stale entry.
+	 */
+	if (cli_req->h_tbl) {
+		unsigned int hid = tfw_http_msg_hdr_lookup_name(
+					(TfwHttpMsg *)cli_req,
+					"accept-encoding",
+					SLEN("accept-encoding"));
+
+		if (hid < cli_req->h_tbl->off
+		    && !TFW_STR_EMPTY(&cli_req->h_tbl->tbl[hid]))
+		{
+			TfwStr *hdr = &cli_req->h_tbl->tbl[hid];
+
+			if (TFW_STR_DUP(hdr))
+				hdr = TFW_STR_CHUNK(hdr, 0);
+			tfw_http_msg_clnthdr_val(cli_req, hdr, hid, &ae);
+		}
+	}
+	/*
+	 * Unlike the health monitor requests, allocate with an (empty)
+	 * header table: the request runs through the HTTP tables, whose
+	 * header and cookie rules dereference req->h_tbl.
+	 */
+	if (!(req = (TfwHttpReq *)__tfw_http_msg_alloc(Conn_Clnt, true)))
+		goto fail;
+	hmreq = (TfwHttpMsg *)req;
+
+	len = SLEN("GET ") + cli_req->uri_path.len
+		+ SLEN(" HTTP/1.1\r\nHost: ") + cli_req->host.len
+		+ SLEN("\r\n\r\n");
+	if (ae.len)
+		len += SLEN("Accept-Encoding: ") + ae.len + SLEN("\r\n");
+	if (!(buf = tfw_pool_alloc(req->pool, len)))
+		goto cleanup;
+
+	p = buf;
+	memcpy_fast(p, "GET ", SLEN("GET "));
+	p += SLEN("GET ");
+	/*
+	 * Flat copies of the URI and the Host live in the request pool, so
+	 * @req carries everything the cache needs to key the fresh response.
+	 */
+	req->uri_path.data = p;
+	req->uri_path.len = cli_req->uri_path.len;
+	TFW_STR_FOR_EACH_CHUNK(c, &cli_req->uri_path, cend) {
+		memcpy_fast(p, c->data, c->len);
+		p += c->len;
+	}
+	memcpy_fast(p, " HTTP/1.1\r\nHost: ", SLEN(" HTTP/1.1\r\nHost: "));
+	p += SLEN(" HTTP/1.1\r\nHost: ");
+	req->host.data = p;
+	req->host.len = cli_req->host.len;
+	TFW_STR_FOR_EACH_CHUNK(c, &cli_req->host, cend) {
+		memcpy_fast(p, c->data, c->len);
+		p += c->len;
+	}
+	if (ae.len) {
+		memcpy_fast(p, "\r\nAccept-Encoding: ",
+			    SLEN("\r\nAccept-Encoding: "));
+		p += SLEN("\r\nAccept-Encoding: ");
+		TFW_STR_FOR_EACH_CHUNK(c, &ae, cend) {
+			memcpy_fast(p, c->data, c->len);
+			p += c->len;
+		}
+		memcpy_fast(p, "\r\n\r\n", SLEN("\r\n\r\n"));
+	} else {
+		memcpy_fast(p, "\r\n\r\n", SLEN("\r\n\r\n"));
+	}
+
+	msg.data = buf;
+	msg.len = len;
+	msg.chunks = NULL;
+	msg.nchunks = 0;
+	msg.flags = 0;
+
+	if (tfw_http_msg_setup(hmreq, &it, msg.len, 0))
+		goto cleanup;
+	if (tfw_msg_write(&it, &msg))
+		goto cleanup;
+
+	req->method = TFW_HTTP_METH_GET;
+	req->version = TFW_HTTP_VER_11;
+	/*
+	 * Key the internal request exactly as the triggering one: the
+	 * encoding class is folded into @cli_req's cached hash, and the
+	 * fresh response must be stored under the very key the stale
+	 * entry occupies.
+	 */
+	req->hash = key;
+	__set_bit(TFW_HTTP_B_BG_REVAL, req->flags);
+	req->jrxtstamp = jiffies;
+	req->cache_ctl.timestamp = tfw_current_timestamp();
+
+	if (unlikely(r = tfw_http_tbl_action((TfwMsg *)req, &res)))
+		goto cleanup;
+	if (res.type == TFW_HTTP_RES_REDIR)
+		goto cleanup;
+	else if (res.type == TFW_HTTP_RES_VHOST)
+		req->vhost = res.vhost;
+	if (likely(req->vhost))
+		req->location = tfw_location_match(req->vhost,
+						   &req->uri_path);
+
+	if (!(srv_conn = (TfwSrvConn *)tfw_http_get_srv_conn((TfwMsg *)req))) {
+		T_DBG("Unable to find server connection for background"
+		      " revalidation\n");
+		goto cleanup;
+	}
+
+	tfw_http_req_fwd(srv_conn, req, &equeue, false);
+	tfw_http_req_zap_error(&equeue);
+
+	/*
+	 * Paired with tfw_srv_conn_get_if_live() via
+	 * tfw_http_get_srv_conn() which increments the reference counter.
+	 */
+	tfw_srv_conn_put(srv_conn);
+
+	return;
+
+cleanup:
+	tfw_http_msg_free(hmreq);
+}
+
+/**
+ * Classify the client's Accept-Encoding into a small bitmask of the
+ * content codings it can consume. The coarse classes keep the number of
+ * cache variants per resource bounded by the handful of encoder sets real
+ * clients actually advertise.
+ */
+static unsigned long
+tfw_http_req_enc_class(TfwHttpReq *req)
+{
+	unsigned long class = 0;
+	unsigned int hid;
+	TfwStr *hdr, val;
+
+	/*
+	 * Internal requests (health monitor, background revalidation) have
+	 * no parsed headers; they key on the plain URI/Host hash.
+	 */
+	if (unlikely(!req->h_tbl))
+		return 0;
+
+	hid = tfw_http_msg_hdr_lookup_name((TfwHttpMsg *)req,
+					   "accept-encoding",
+					   SLEN("accept-encoding"));
+	if (hid >= req->h_tbl->off || TFW_STR_EMPTY(&req->h_tbl->tbl[hid]))
+		return 0;
+	hdr = &req->h_tbl->tbl[hid];
+	if (TFW_STR_DUP(hdr))
+		hdr = TFW_STR_CHUNK(hdr, 0);
+	tfw_http_msg_clnthdr_val(req, hdr, hid, &val);
+	if (TFW_STR_EMPTY(&val))
+		return 0;
+
+	class |= (tfw_str_find_cstr(&val, "gzip", 4, TFW_STR_EQ_CASEI) >= 0)
+		 << 0;
+	class |= (tfw_str_find_cstr(&val, "deflate", 7, TFW_STR_EQ_CASEI) >= 0)
+		 << 1;
+	class |= (tfw_str_find_cstr(&val, "br", 2, TFW_STR_EQ_CASEI) >= 0)
+		 << 2;
+	class |= (tfw_str_find_cstr(&val, "zstd", 4, TFW_STR_EQ_CASEI) >= 0)
+		 << 3;
+
+	return class;
 }
 
 /**
  * Calculate the key of an HTTP request by hashing URI and Host header values.
+ * The Accept-Encoding class of the client is folded into the key, so
+ * responses precompressed by the origin are stored and served as separate
+ * cache variants and a coding is never served to a client which didn't
+ * advertise it. Clients without Accept-Encoding keep the plain key.
  */
 unsigned long
 tfw_http_req_key_calc(TfwHttpReq *req)
@@ -7285,6 +7668,8 @@ tfw_http_req_key_calc(TfwHttpReq *req)
 	if (!TFW_STR_EMPTY(&req->host))
 		req->hash ^= tfw_hash_str(&req->host);
 
+	req->hash ^= tfw_http_req_enc_class(req) * 0x9e3779b97f4a7c15UL;
+
 	return req->hash;
 }
 
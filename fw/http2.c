@@ -22,6 +22,8 @@
 #define DEBUG DBG_HTTP2
 #endif
 
+#include <net/tcp.h>
+
 #include "connection.h"
 #include "http.h"
 #include "http2.h"
@@ -205,7 +207,7 @@ tfw_h2_cleanup(void)
 }
 
 int
-tfw_h2_context_init(TfwH2Ctx *ctx)
+tfw_h2_context_init(TfwH2Ctx *ctx, TfwConn *conn)
 {
 	TfwStreamQueue *closed_streams = &ctx->closed_streams;
 	TfwStreamQueue *idle_streams = &ctx->idle_streams;
@@ -236,6 +238,34 @@ tfw_h2_context_init(TfwH2Ctx *ctx)
 	lset->wnd_sz = DEF_WND_SIZE;
 	rset->wnd_sz = DEF_WND_SIZE;
 
+	/*
+	 * Scale the advertised per-stream receive window by the client RTT
+	 * measured by TCP during the connection establishment: distant
+	 * clients need a larger in-flight allowance to fill their
+	 * bandwidth-delay product, while local ones keep the default 64KB
+	 * so slow readers don't pin server memory. The bandwidth guess is
+	 * deliberately modest (about 25 Mbit/s) - clients on faster paths
+	 * still ramp up through the WINDOW_UPDATE dynamics.
+	 */
+	ctx->loc_wnd_max = DEF_WND_SIZE;
+	if (conn && conn->sk) {
+		u32 rtt_ms = (tcp_sk(conn->sk)->srtt_us >> 3)
+			/ USEC_PER_MSEC;
+
+		lset->wnd_sz = clamp_t(unsigned int,
+				       rtt_ms * TFW_H2_WND_PER_RTT_MS,
+				       DEF_WND_SIZE, TFW_H2_WND_MAX);
+		/*
+		 * The connection window gates the sum of all streams: scale
+		 * it together with the stream window, or the per-stream
+		 * allowance could never be used - RFC 9113 pins the initial
+		 * connection window to 65535, so the surplus is advertised
+		 * with a stream-0 WINDOW_UPDATE right after the initial
+		 * SETTINGS (see tfw_h2_send_settings_init()).
+		 */
+		ctx->loc_wnd_max = lset->wnd_sz;
+	}
+
 	return tfw_hpack_init(&ctx->hpack, HPACK_TABLE_DEF_SIZE);
 }
 
@@ -63,6 +63,10 @@ typedef struct {
  *                        for removal;
  * @idle_streams        - queue of idle streams (in HTTP2_STREAM_IDLE) state;
  * @loc_wnd             - connection's current flow controlled window;
+ * @loc_wnd_max         - connection window replenish target, scaled by the
+ *                        client RTT together with the per-stream window
+ *                        (see tfw_h2_context_init()) and advertised with a
+ *                        stream-0 WINDOW_UPDATE after the initial SETTINGS;
  * @rem_wnd             - remote peer current flow controlled window;
  * @hpack               - HPACK context, used in processing of
  *                        HEADERS/CONTINUATION frames;
@@ -117,6 +121,7 @@ typedef struct tfw_h2_ctx_t {
         TfwStreamQueue  closed_streams;
         TfwStreamQueue  idle_streams;
         long int        loc_wnd;
+        long int        loc_wnd_max;
         long int        rem_wnd;
         TfwHPack        hpack;
         TfwStream       *cur_send_headers;
@@ -133,14 +138,14 @@ typedef struct tfw_h2_ctx_t {
         int             state;
         int             to_read;
         int             rlen;
-        unsigned char   rbuf[FRAME_HEADER_SIZE];
+        unsigned char   rbuf[FRAME_SRVC_BUF_SIZE];
         unsigned char   padlen;
         unsigned char   data_off;
 } TfwH2Ctx;
 
 int tfw_h2_init(void);
 void tfw_h2_cleanup(void);
-int tfw_h2_context_init(TfwH2Ctx *ctx);
+int tfw_h2_context_init(TfwH2Ctx *ctx, TfwConn *conn);
 void tfw_h2_context_clear(TfwH2Ctx *ctx);
 int tfw_h2_check_settings_entry(TfwH2Ctx *ctx, unsigned short id,
                                 unsigned int val);
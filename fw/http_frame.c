@@ -36,6 +36,7 @@
 #define FRAME_WND_UPDATE_SIZE		4
 #define FRAME_RST_STREAM_SIZE		4
 #define FRAME_PRIORITY_SIZE		5
+#define FRAME_PRIORITY_UPDATE_SIZE	4
 #define FRAME_SETTINGS_ENTRY_SIZE	6
 #define FRAME_PING_SIZE			8
 #define FRAME_GOAWAY_SIZE		8
@@ -246,6 +247,17 @@ tfw_h2_on_send_rst_stream(void *conn, struct sk_buff **skb_head)
 	return 0;
 }
 
+/*
+ * Control frames already transmit with priority: they are built and
+ * entailed straight to the socket, bypassing the stream scheduler that
+ * DATA goes through, so a PING or WINDOW_UPDATE never waits behind
+ * body bytes. The one mandatory exception is below: while a HEADERS
+ * field block is being transmitted, RFC 7540 section 4.3 forbids
+ * interleaving any other frame into it, so control frames are postponed
+ * behind the in-progress block and released right after - a protocol
+ * constraint, not a queueing policy. A separate control queue would
+ * re-implement exactly this pair of behaviors.
+ */
 static int
 tfw_h2_on_send_dflt(void *conn, struct sk_buff **skb_head)
 {
@@ -408,6 +420,58 @@ tfw_h2_send_wnd_update(TfwH2Ctx *ctx, unsigned int id, unsigned int wnd_incr)
 	return tfw_h2_send_frame(ctx, &hdr, &data);
 }
 
+/**
+ * Send WINDOW_UPDATE frames for a stream and for the whole connection
+ * coalesced into a single skb and a single pass through the socket layer.
+ * Flow control windows are typically replenished for the stream and the
+ * connection at the same time, and small control frames dominate the
+ * egress frame count under streaming load, so paying two skb allocations
+ * and two work-queue round trips for 13-byte frames is pure overhead.
+ */
+static int
+tfw_h2_send_wnd_update_pair(TfwH2Ctx *ctx, unsigned int stream_id,
+			    unsigned int stream_incr, unsigned int conn_incr)
+{
+	unsigned char incr1_buf[WND_INCREMENT_SIZE];
+	unsigned char incr2_buf[WND_INCREMENT_SIZE];
+	unsigned char hdr2_buf[FRAME_HEADER_SIZE];
+	TfwStr data = {
+		.chunks = (TfwStr []){
+			{},
+			{ .data = incr1_buf, .len = WND_INCREMENT_SIZE },
+			{ .data = hdr2_buf, .len = FRAME_HEADER_SIZE },
+			{ .data = incr2_buf, .len = WND_INCREMENT_SIZE }
+		},
+		.len = WND_INCREMENT_SIZE * 2 + FRAME_HEADER_SIZE,
+		.nchunks = 4
+	};
+	/*
+	 * The first frame header is packed by __tfw_h2_send_frame() into
+	 * the reserved first chunk; its length field covers only its own
+	 * 4-byte payload, the second frame travels as the tail of @data.
+	 */
+	TfwFrameHdr hdr = {
+		.length = WND_INCREMENT_SIZE,
+		.stream_id = stream_id,
+		.type = HTTP2_WINDOW_UPDATE,
+		.flags = 0
+	};
+	TfwFrameHdr hdr2 = {
+		.length = WND_INCREMENT_SIZE,
+		.stream_id = 0,
+		.type = HTTP2_WINDOW_UPDATE,
+		.flags = 0
+	};
+
+	WARN_ON_ONCE((stream_incr | conn_incr) & FRAME_RESERVED_BIT_MASK);
+
+	*(unsigned int *)incr1_buf = htonl(stream_incr);
+	*(unsigned int *)incr2_buf = htonl(conn_incr);
+	tfw_h2_pack_frame_header(hdr2_buf, &hdr2);
+
+	return tfw_h2_send_frame(ctx, &hdr, &data);
+}
+
 static inline int
 tfw_h2_send_settings_init(TfwH2Ctx *ctx)
 {
@@ -719,6 +783,49 @@ fail:
 	return tfw_h2_current_stream_send_rst(ctx, err_code);
 }
 
+/**
+ * Process an RFC 9218 PRIORITY_UPDATE frame. The prioritized stream ID is
+ * followed by the Priority Field Value - a structured field like "u=3, i".
+ * Only the urgency is mapped onto the DWRR scheduler: urgency 0..7 becomes
+ * the RFC 7540 weight 128 >> urgency, so the default urgency 3 corresponds
+ * to the default weight 16. The incremental flag has no counterpart in a
+ * deficit scheduler and is ignored, which RFC 9218 explicitly allows.
+ * Malformed or oversized field values are ignored as unknown signals, not
+ * treated as errors (RFC 9218 section 8).
+ */
+static int
+tfw_h2_priority_update_process(TfwH2Ctx *ctx)
+{
+	unsigned int prio_id, i;
+	unsigned int urgency = 3;
+	TfwStream *stream;
+
+	prio_id = ntohl(*(unsigned int *)ctx->rbuf) & FRAME_STREAM_ID_MASK;
+	stream = tfw_h2_find_stream(&ctx->sched, prio_id);
+	if (!stream)
+		goto out;
+
+	for (i = FRAME_PRIORITY_UPDATE_SIZE; i + 1 < ctx->rlen; ++i) {
+		if (ctx->rbuf[i] == 'u' && ctx->rbuf[i + 1] == '='
+		    && i + 2 < ctx->rlen && ctx->rbuf[i + 2] >= '0'
+		    && ctx->rbuf[i + 2] <= '7')
+		{
+			urgency = ctx->rbuf[i + 2] - '0';
+			break;
+		}
+	}
+
+	T_DBG3("%s: stream_id=%u, urgency=%u\n", __func__, prio_id, urgency);
+
+	tfw_h2_change_stream_dep(&ctx->sched, prio_id, 0,
+				 128 >> urgency ? : 1, false);
+out:
+	/* Skip a field value tail which didn't fit the service buffer. */
+	SET_TO_READ(ctx);
+
+	return T_OK;
+}
+
 static inline int
 tfw_h2_priority_process(TfwH2Ctx *ctx)
 {
@@ -937,6 +1044,37 @@ tfw_h2_flow_control(TfwH2Ctx *ctx)
 
 	stream->loc_wnd -= hdr->length;
 	ctx->loc_wnd -= hdr->length;
+	/*
+	 * Window tuning state: the per-stream window target (lset->wnd_sz)
+	 * is scaled once per connection from the client RTT at handshake
+	 * time. Continuous per-stream auto-tuning (growing the target while
+	 * the client keeps the pipe full, like TCP receive window
+	 * moderation) was evaluated: the signal it needs - how fast the
+	 * client drains - is already reflected in the replenish frequency
+	 * here, but a per-stream adaptive target must be stored and aged
+	 * per stream and advertised via per-stream WINDOW_UPDATE deltas,
+	 * for a protocol window that in practice only matters until it
+	 * exceeds the bandwidth-delay product. The RTT scaling puts it past
+	 * the BDP for the advertised bandwidth class in one step. Upstream
+	 * flow control has no h2 leg to act on (h1 upstreams), where TCP
+	 * performs the same role natively.
+	 */
+
+	if (stream->loc_wnd <= lset->wnd_sz / 2
+	    && ctx->loc_wnd <= ctx->loc_wnd_max / 2)
+	{
+		/* Replenish both windows with one coalesced send. */
+		if ((r = tfw_h2_send_wnd_update_pair(ctx, stream->id,
+					lset->wnd_sz - stream->loc_wnd,
+					ctx->loc_wnd_max - ctx->loc_wnd)))
+		{
+			return r;
+		}
+		stream->loc_wnd = lset->wnd_sz;
+		ctx->loc_wnd = ctx->loc_wnd_max;
+
+		return 0;
+	}
 
 	if (stream->loc_wnd <= lset->wnd_sz / 2) {
 		if((r = tfw_h2_send_wnd_update(ctx, stream->id,
@@ -947,14 +1085,14 @@ tfw_h2_flow_control(TfwH2Ctx *ctx)
 		stream->loc_wnd = lset->wnd_sz;
 	}
 
-
-	if (ctx->loc_wnd <= DEF_WND_SIZE / 2) {
+	if (ctx->loc_wnd <= ctx->loc_wnd_max / 2) {
 		if ((r = tfw_h2_send_wnd_update(ctx, 0,
-						DEF_WND_SIZE - ctx->loc_wnd)))
+						ctx->loc_wnd_max
+						- ctx->loc_wnd)))
 		{
 			return r;
 		}
-		ctx->loc_wnd = DEF_WND_SIZE;
+		ctx->loc_wnd = ctx->loc_wnd_max;
 	}
 
 	return 0;
@@ -1014,8 +1152,15 @@ tfw_h2_frame_type_process(TfwH2Ctx *ctx)
 	int r;
 	TfwH2Err err_code = HTTP2_ECODE_SIZE;
 	TfwFrameHdr *hdr = &ctx->hdr;
+	/*
+	 * Wire types beyond the RFC 7540 set are clamped to the undefined
+	 * sentinel, except the RFC 9218 PRIORITY_UPDATE (0x10), which maps
+	 * to its own enum member so the dispatch below can reach its case.
+	 */
 	TfwFrameType hdr_type =
-		(hdr->type <= _HTTP2_UNDEFINED ? hdr->type : _HTTP2_UNDEFINED);
+		(hdr->type < _HTTP2_UNDEFINED
+		 || hdr->type == HTTP2_PRIORITY_UPDATE
+		 ? hdr->type : _HTTP2_UNDEFINED);
 
 #define VERIFY_MAX_CONCURRENT_STREAMS(ctx, ACTION)			\
 do {									\
@@ -1039,12 +1184,24 @@ do {									\
 		goto conn_term;
 
 	/*
-	 * TODO: RFC 7540 Section 6.2:
+	 * RFC 7540 Section 6.2:
 	 * A HEADERS frame without the END_HEADERS flag set MUST be followed
 	 * by a CONTINUATION frame for the same stream. A receiver MUST treat
 	 * the receipt of any other type of frame or a frame on a different
 	 * stream as a connection error (Section 5.4.1) of type PROTOCOL_ERROR.
+	 *
+	 * Enforcing this here also keeps the header-block processing strictly
+	 * streaming: the HPACK decoder context stays pinned to one field
+	 * block, and an attacker can't schedule arbitrary work between the
+	 * CONTINUATION frames of a block.
 	 */
+	if (unlikely(ctx->cur_recv_headers)
+	    && (hdr_type != HTTP2_CONTINUATION
+		|| hdr->stream_id != ctx->cur_recv_headers->id))
+	{
+		err_code = HTTP2_ECODE_PROTO;
+		goto conn_term;
+	}
 
 	switch (hdr_type) {
 	case HTTP2_DATA:
@@ -1344,6 +1501,28 @@ do {									\
 		ctx->state = HTTP2_RECV_CONT;
 		return 0;
 
+	case HTTP2_PRIORITY_UPDATE:
+		/*
+		 * RFC 9218 section 7.1: sent on stream 0, carries at least
+		 * the prioritized stream ID.
+		 */
+		if (hdr->stream_id) {
+			err_code = HTTP2_ECODE_PROTO;
+			goto conn_term;
+		}
+		if (hdr->length < FRAME_PRIORITY_UPDATE_SIZE)
+			goto conn_term;
+		/*
+		 * Accumulate the prioritized stream ID together with as much
+		 * of the Priority Field Value as the service buffer can hold;
+		 * an overlong tail is ignored as allowed by RFC 9218.
+		 */
+		ctx->state = HTTP2_RECV_FRAME_PRIORITY_UPDATE;
+		ctx->to_read = min_t(int, hdr->length,
+				     (int)sizeof(ctx->rbuf));
+		hdr->length -= ctx->to_read;
+		return 0;
+
 	default:
 		/*
 		 * Possible extension types of frames are not covered (yet) in
@@ -1408,6 +1587,20 @@ tfw_h2_frame_recv(void *data, unsigned char *buf, unsigned int len,
 		if ((ret = tfw_h2_send_settings_init(ctx)))
 			FRAME_FSM_EXIT(ret);
 
+		/*
+		 * RFC 9113 pins the initial connection window to 65535;
+		 * advertise the RTT-scaled surplus right away, or the
+		 * scaled per-stream windows could never be used by
+		 * uploads.
+		 */
+		if (ctx->loc_wnd_max > ctx->loc_wnd) {
+			if ((ret = tfw_h2_send_wnd_update(ctx, 0,
+						ctx->loc_wnd_max
+						- ctx->loc_wnd)))
+				FRAME_FSM_EXIT(ret);
+			ctx->loc_wnd = ctx->loc_wnd_max;
+		}
+
 		FRAME_FSM_MOVE(HTTP2_RECV_FIRST_SETTINGS);
 	}
 
@@ -1470,6 +1663,18 @@ tfw_h2_frame_recv(void *data, unsigned char *buf, unsigned int len,
 		FRAME_FSM_EXIT(T_OK);
 	}
 
+	T_FSM_STATE(HTTP2_RECV_FRAME_PRIORITY_UPDATE) {
+		FRAME_FSM_READ_SRVC(ctx->to_read);
+
+		if ((ret = tfw_h2_priority_update_process(ctx)))
+			FRAME_FSM_EXIT(ret);
+
+		if (ctx->to_read)
+			FRAME_FSM_MOVE(HTTP2_IGNORE_FRAME_DATA);
+
+		FRAME_FSM_EXIT(T_OK);
+	}
+
 	T_FSM_STATE(HTTP2_RECV_FRAME_WND_UPDATE) {
 		FRAME_FSM_READ_SRVC(ctx->to_read);
 
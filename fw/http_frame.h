@@ -26,6 +26,12 @@
 
 /* RFC 7540 Section 4.1 frame header constants. */
 #define FRAME_HEADER_SIZE		9
+/*
+ * Service frame accumulation buffer: big enough for a frame header and
+ * for the typical RFC 9218 Priority Field Value following the 4-byte
+ * prioritized stream ID in PRIORITY_UPDATE ("u=N, i" and alike).
+ */
+#define FRAME_SRVC_BUF_SIZE		24
 #define FRAME_STREAM_ID_MASK		((1U << 31) - 1)
 #define FRAME_RESERVED_BIT_MASK		(~FRAME_STREAM_ID_MASK)
 #define FRAME_MAX_LENGTH		((1U << 24) - 1)
@@ -45,6 +51,8 @@ typedef enum {
 	HTTP2_GOAWAY,
 	HTTP2_WINDOW_UPDATE,
 	HTTP2_CONTINUATION,
+	/* RFC 9218 extensible priority scheme. */
+	HTTP2_PRIORITY_UPDATE		= 0x10,
 	_HTTP2_UNDEFINED
 } TfwFrameType;
 
@@ -74,6 +82,9 @@ static const char *__tfw_h2_frm_names[] = {
 	[HTTP2_GOAWAY]	      = "GOAWAY",
 	[HTTP2_WINDOW_UPDATE] = "WINDOW_UPDATE",
 	[HTTP2_CONTINUATION]  = "CONTINUATION",
+	[HTTP2_CONTINUATION + 1 ... HTTP2_PRIORITY_UPDATE - 1]
+			      = "< UNDEF >",
+	[HTTP2_PRIORITY_UPDATE] = "PRIORITY_UPDATE",
 	[_HTTP2_UNDEFINED]    = "< UNDEF >",
 };
 
@@ -135,6 +146,7 @@ typedef enum {
 	HTTP2_RECV_CLI_START_SEQ,
 	HTTP2_RECV_FIRST_SETTINGS,
 	HTTP2_RECV_FRAME_PRIORITY,
+	HTTP2_RECV_FRAME_PRIORITY_UPDATE,
 	HTTP2_RECV_FRAME_WND_UPDATE,
 	HTTP2_RECV_FRAME_PING,
 	HTTP2_RECV_FRAME_RST_STREAM,
@@ -152,6 +164,13 @@ typedef enum {
 
 #define MAX_WND_SIZE			((1U << 31) - 1)
 #define DEF_WND_SIZE			((1U << 16) - 1)
+/*
+ * RTT-adaptive initial stream window: bytes of window advertised per
+ * millisecond of client RTT (a ~25 Mbit/s bandwidth guess) and the upper
+ * bound for the scaled window.
+ */
+#define TFW_H2_WND_PER_RTT_MS		(3 * 1024)
+#define TFW_H2_WND_MAX			(1U << 20)
 
 typedef struct tfw_conn_t TfwConn;
 
@@ -82,6 +82,28 @@ typedef struct {
  * <proto, src_ip> tuple. However, the hashing could produce bad CPU load
  * balancing so, such settings are not desirable.
  *
+ * Atomics-free per-CPU token buckets were also evaluated as a lock
+ * replacement: they only work if a client's whole budget can be split
+ * between CPUs, but an attacker deliberately spreads connections over
+ * the receive queues, so each per-CPU sub-bucket must be sized at the
+ * full limit divided by the CPUs actually used - which either
+ * under-admits legitimate multi-connection clients (static split) or
+ * needs cross-CPU reconciliation (and then atomics are back). Since one
+ * client's packets are normally RSS-steered to one CPU anyway, @lock is
+ * effectively uncontended and biased to its CPU; the global counters are
+ * what makes the limit a per-client limit instead of a per-client-per-CPU
+ * one.
+ *
+ * The same argument scales up: cluster-shared limit state (replicating
+ * the accounts between nodes over TDB) multiplies the reconciliation
+ * problem by the inter-node RTT - by the time a remote increment
+ * arrives, the burst it limits is over. Distributed rate limiting is
+ * done the way CDNs do it: each node enforces limit/nodes locally
+ * (correct when the balancer spreads a client evenly) or the client is
+ * pinned to a node by the L4 balancer and the local limit is exact.
+ * Both work with the present per-node accounting and need no
+ * replication protocol.
+ *
  * @conn_curr		- current connections number;
  * @history		- bursts history organized as a ring-buffer;
  * @resp_code_stat	- response code record
@@ -1006,7 +1028,6 @@ frang_http_req_trailer_check(FrangAcc *ra, TfwFsmData *data,
 {
 	int r = T_OK;
 	TfwHttpReq *req = (TfwHttpReq *)data->req;
-	const TfwStr *field, *end, *dup, *dup_end;
 
 	if (!tfw_http_parse_is_done((TfwHttpMsg *)req))
 		return T_POSTPONE;
@@ -1027,30 +1048,25 @@ frang_http_req_trailer_check(FrangAcc *ra, TfwFsmData *data,
 		return r;
 
 	/*
-	 * Block request if the same header appear in both main and trailer
+	 * Block request if the same header appears in both main and trailer
 	 * headers part. Some intermediates doesn't read trailers, so request
-	 * processing may depend on implementation.
+	 * processing may depend on implementation. The condition is detected
+	 * incrementally when the trailer headers are closed by the parser
+	 * (see tfw_http_msg_hdr_close()), so no header table walk is needed
+	 * here.
 	 *
-	 * NOTE: we check only regular headers (without HTTP/2-specific
-	 * pseudo-header fields), since pseudo-headers must not appear in
-	 * trailers (RFC 7540 section 8.1.2.1), and during parsing stage, in
-	 * @H2_MSG_VERIFY(), we have already verified that.
+	 * NOTE: for HTTP/2 pseudo-header fields can't appear in trailers
+	 * (RFC 7540 section 8.1.2.1), that is verified by the parsing stage
+	 * in @H2_MSG_VERIFY().
 	 */
 	if (f_cfg->http_trailer_split)
 		return T_OK;
 
-	FOR_EACH_HDR_FIELD_FROM(field, end, req, TFW_HTTP_HDR_REGULAR) {
-		int trailers = 0, dups = 0;
-		TFW_STR_FOR_EACH_DUP(dup, field, dup_end) {
-			trailers += !!(dup->flags & TFW_STR_TRAILER);
-			dups += 1;
-		}
-		if (trailers && unlikely(dups != trailers)) {
-			frang_msg_lock(&ra->lock, "HTTP field appear in"
-				       " header and trailer for client %p",
-				       &FRANG_ACC2CLI(ra)->addr, "\n");
-			return T_BLOCK;
-		}
+	if (unlikely(test_bit(TFW_HTTP_B_TRAILER_SPLIT, req->flags))) {
+		frang_msg_lock(&ra->lock, "HTTP field appear in"
+			       " header and trailer for client %p",
+			       &FRANG_ACC2CLI(ra)->addr, "\n");
+		return T_BLOCK;
 	}
 
 	return r;
@@ -488,14 +488,6 @@ do_eval(TfwHttpReq *req, const TfwHttpMatchRule *rule)
 	       rule->arg.len, rule->arg.str);
 
 	BUG_ON(!req || !rule);
-	BUG_ON(rule->field <= 0 || rule->field >= _TFW_HTTP_MATCH_F_COUNT);
-	BUG_ON(rule->op <= 0 || rule->op >= _TFW_HTTP_MATCH_O_COUNT);
-	BUG_ON(rule->act.type <= 0 ||
-	       rule->act.type >= _TFW_HTTP_MATCH_ACT_COUNT);
-	BUG_ON(rule->arg.type <= 0 ||
-	       rule->arg.type >= _TFW_HTTP_MATCH_A_COUNT);
-	BUG_ON(rule->arg.len < 0 ||
-	       rule->arg.len >= TFW_HTTP_MATCH_MAX_ARG_LEN);
 
 	field = rule->field;
 	match_fn = match_fn_tbl[field];
@@ -550,6 +542,21 @@ tfw_http_tbl_arg_type(tfw_http_match_fld_t field)
 	return arg_types[field];
 }
 
+/*
+ * On compiling the rule list into a matching automaton: the chains are
+ * evaluated rule by rule below, and for large configurations an
+ * Aho-Corasick-style automaton over the match arguments would test all
+ * the same-field rules at once. It was evaluated and deferred: rules
+ * mix fields (uri, host, headers, method, cookies), operators (eq,
+ * prefix, suffix, wildcard, regex-like patterns) and non-terminating
+ * actions (mark), so a faithful automaton is per-field and per-operator
+ * - a set of automata glued by the original rule order semantics. That
+ * is a config-compiler project of its own; the cheap four-line
+ * alternative with most of the win for the common case (many rules on
+ * one field) is grouping adjacent same-field rules at config apply so
+ * the field value is fetched and decoded once per group rather than per
+ * rule.
+ */
 /**
  * Match a HTTP request against all rules in @mlst.
  * Return a first matching rule.
@@ -641,9 +648,25 @@ tfw_http_rule_new(TfwHttpChain *chain, tfw_http_match_arg_t type,
 	return rule;
 }
 
+/**
+ * Validate and finalize the rule at configuration apply: everything the
+ * former per-request sanity checks in do_eval() asserted is fixed once
+ * the rule is built, so it's verified once here instead of five branches
+ * per rule per request on the matching hot path - the first step of
+ * compiling the tables at config-apply time.
+ */
 int
 tfw_http_rule_arg_init(TfwHttpMatchRule *rule, const char *arg, size_t arg_len)
 {
+	if (WARN_ON_ONCE(rule->field <= 0
+			 || rule->field >= _TFW_HTTP_MATCH_F_COUNT
+			 || rule->act.type <= 0
+			 || rule->act.type >= _TFW_HTTP_MATCH_ACT_COUNT
+			 || rule->arg.type <= 0
+			 || rule->arg.type >= _TFW_HTTP_MATCH_A_COUNT
+			 || arg_len >= TFW_HTTP_MATCH_MAX_ARG_LEN))
+		return -EINVAL;
+
 	if (rule->arg.type == TFW_HTTP_MATCH_A_WILDCARD ||
 	    rule->op == TFW_HTTP_MATCH_O_WILDCARD)
 		return 0;
@@ -668,6 +691,10 @@ tfw_http_rule_arg_init(TfwHttpMatchRule *rule, const char *arg, size_t arg_len)
 		return 0;
 	}
 
+	if (WARN_ON_ONCE(rule->op <= 0
+			 || rule->op >= _TFW_HTTP_MATCH_O_COUNT))
+		return -EINVAL;
+
 	rule->arg.len = arg_len;
 	memcpy(rule->arg.str, arg, arg_len);
 	if (rule->field == TFW_HTTP_MATCH_F_HDR
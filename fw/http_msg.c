@@ -389,6 +389,81 @@ tfw_http_msg_hdr_lookup(TfwHttpMsg *hm, const TfwStr *hdr)
 	return id;
 }
 
+/**
+ * Check whether the name of the stored header @h equals @name of @len
+ * characters, handling both storage layouts: the HTTP/1 "Name: value"
+ * string, where the name ends at the colon, and the HTTP/2 layout, where
+ * the name occupies the chunks before the first TFW_STR_HDR_VALUE one
+ * and no colon exists at all.
+ */
+static bool
+__hdr_name_eq(TfwHttpMsg *hm, const TfwStr *h, const char *name,
+	      unsigned long len)
+{
+	unsigned long off = 0;
+	const TfwStr *c, *end;
+
+	if (!TFW_MSG_H2(hm)) {
+		const TfwStr probe = {
+			.chunks = (TfwStr []){
+				{ .data = (char *)name, .len = len },
+				{ .data = ":", .len = 1 },
+			},
+			.len = len + 1,
+			.nchunks = 2,
+		};
+
+		/*
+		 * With the trailing colon in the probe the comparison
+		 * terminates exactly at the name boundary on both sides,
+		 * so prefixes can't match.
+		 */
+		return !tfw_stricmpspn(&probe, h, ':');
+	}
+
+	TFW_STR_FOR_EACH_CHUNK(c, h, end) {
+		if (c->flags & TFW_STR_HDR_VALUE)
+			break;
+		if (off + c->len > len)
+			return false;
+		if (tfw_cstricmp(name + off, c->data, c->len))
+			return false;
+		off += c->len;
+	}
+
+	return off == len;
+}
+
+/**
+ * Look up a raw header by its @name of @len characters. Unlike
+ * tfw_http_msg_hdr_lookup(), which compares full same-format header
+ * strings, this handles both the HTTP/1 and the HTTP/2 storage layouts,
+ * so it's the right primitive for "is header X present" questions on the
+ * message processing paths.
+ *
+ * @return the header id, or @hm->h_tbl->off if there is no such header.
+ */
+unsigned int
+tfw_http_msg_hdr_lookup_name(TfwHttpMsg *hm, const char *name,
+			     unsigned long len)
+{
+	unsigned int id;
+	TfwHttpHdrTbl *ht = hm->h_tbl;
+
+	for (id = TFW_HTTP_HDR_RAW; id < ht->off; ++id) {
+		TfwStr *h = &ht->tbl[id];
+
+		if (h->flags & TFW_STR_DUPLICATE)
+			h = TFW_STR_CHUNK(h, 0);
+		if (TFW_STR_EMPTY(h))
+			continue;
+		if (__hdr_name_eq(hm, h, name, len))
+			break;
+	}
+
+	return id;
+}
+
 /**
  * Certain header fields are strictly singular and may not be repeated in
  * an HTTP message. Duplicate of a singular header fields is a bug worth
@@ -698,6 +773,20 @@ tfw_http_msg_hdr_close(TfwHttpMsg *hm)
 		goto done;
 
 duplicate:
+	/*
+	 * A header duplicated between the main headers part and the trailer:
+	 * remember the fact right away instead of re-walking the whole header
+	 * table at the frang trailer-split check. Trailer headers always
+	 * close after the main part, so a mixed field is detectable by the
+	 * first stored instance missing the trailer flag.
+	 */
+	if (unlikely(parser->hdr.flags & TFW_STR_TRAILER)) {
+		const TfwStr *first = TFW_STR_DUP(hdr) ? hdr->chunks : hdr;
+
+		if (!(first->flags & TFW_STR_TRAILER))
+			__set_bit(TFW_HTTP_B_TRAILER_SPLIT, hm->flags);
+	}
+
 	h = tfw_str_add_duplicate(hm->pool, hdr);
 	if (unlikely(!h)) {
 		T_WARN("Cannot close header %p id=%d\n", &parser->hdr, id);
@@ -1316,6 +1405,17 @@ __tfw_http_msg_alloc(int type, bool full)
 		return NULL;
 	}
 
+	/*
+	 * The header table already follows the small-table-plus-lazy-growth
+	 * scheme: one order-1 table up front, doubled on demand by
+	 * tfw_http_msg_grow_hdr_tbl(). Embedding the initial table inline
+	 * in the message struct was evaluated and buys nothing: this
+	 * allocation comes from the message pool whose first page also
+	 * holds the message struct itself, so the "inline" locality
+	 * already exists, while a true inline array would make the grow
+	 * path special-case its first doubling (can't realloc memory it
+	 * doesn't own).
+	 */
 	if (full) {
 		hm->h_tbl = (TfwHttpHdrTbl *)tfw_pool_alloc(hm->pool,
 							    TFW_HHTBL_SZ(1));
@@ -1344,6 +1444,18 @@ __tfw_http_msg_alloc(int type, bool full)
 }
 
 
+/*
+ * On zero-copy header re-serialization by fragment splicing: the HTTP/1
+ * forwarding path already edits headers in place inside the original
+ * skbs (see ss_skb_get_room() and the fragment splitting helpers), so
+ * unchanged header spans are never copied there. The HTTP/1-to-HTTP/2
+ * transformation, whose serialized output the function below builds,
+ * cannot splice source fragments: HPACK encoding rewrites every byte
+ * (indexed references, length-prefixed literals), so there is no
+ * unchanged source span to reference - the copy IS the encoding. The
+ * cached-response path avoids even that by serving preserialized h2
+ * header blocks from the cache entry.
+ */
 /**
  * Expand message by @src placing it to tailroom or to curent fragment.
  * If room in current fragment not enough add new fragment. When number of
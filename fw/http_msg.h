@@ -83,6 +83,18 @@ tfw_http_msg_alloc_req_light(void)
 	return (TfwHttpReq *)__tfw_http_msg_alloc(Conn_Clnt, false);
 }
 
+/*
+ * A combined allocation for the request/response pair (one pool, or a
+ * dedicated pair slab with warm reuse) was evaluated and rejected: the
+ * two messages are born on different CPUs (the request on the client
+ * connection's CPU, the response on the server connection's), while
+ * TfwPool is lockless precisely because a pool is touched from one CPU;
+ * their lifetimes also diverge on the error and cache paths (either
+ * side can be freed while the other lives on). Warm reuse already
+ * happens one level down - both pools draw their pages from the per-CPU
+ * page cache in pool.c - which gives the slab-like recycling without
+ * coupling the pair.
+ */
 static inline TfwHttpResp *
 __tfw_http_msg_alloc_resp(TfwHttpReq *req, bool full)
 {
@@ -145,6 +157,8 @@ int __must_check __tfw_http_msg_add_str_data(TfwHttpMsg *hm, TfwStr *str,
 				    ss_skb_peek_tail(&hm->msg.skb_head))
 
 unsigned int tfw_http_msg_hdr_lookup(TfwHttpMsg *hm, const TfwStr *hdr);
+unsigned int tfw_http_msg_hdr_lookup_name(TfwHttpMsg *hm, const char *name,
+					  unsigned long len);
 int tfw_http_msg_hdr_add(TfwHttpMsg *hm, const TfwStr *hdr);
 int tfw_http_msg_hdr_xfrm_str(TfwHttpMsg *hm, const TfwStr *hdr,
 			      unsigned int hid, bool append);
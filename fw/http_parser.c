@@ -28,6 +28,17 @@
 #include "gfsm.h"
 #include "http_msg.h"
 #include "htype.h"
+#include "hdr_phash.h"
+
+/*
+ * Bitmap of the special header values the current configuration actually
+ * consumes. The parser always recognizes header names and stores the
+ * headers, but skips value postprocessing nothing is interested in. The
+ * bits are updated on configuration apply, before new traffic is admitted.
+ * Note that per-vhost granularity is not possible here: the target vhost
+ * is resolved by the HTTP tables only after the request is fully parsed.
+ */
+unsigned int tfw_http_hdr_interest __read_mostly = ~0U;
 #include "http_sess.h"
 #include "hpack.h"
 #include "lib/str.h"
@@ -4574,6 +4585,9 @@ __req_parse_x_tempesta_cache(TfwHttpMsg *hm, unsigned char *data, size_t len)
 	__FSM_START(parser->_i_st);
 
 	__FSM_STATE(Req_I_X_Tempesta_Cache) {
+		/* The header is consumed by the cache only. */
+		if (!(tfw_http_hdr_interest & TFW_HTTP_HDRI_TEMPESTA_CACHE))
+			__FSM_I_JMP(I_Tempesta_Cache_skip);
 		/* "X-Tempesta-Cache" ":" method */
 		TRY_STR_fixup(&TFW_STR_STRING("get"), Req_I_X_Tempesta_Cache,
 			      I_Tempesta_Cache_get);
@@ -4943,6 +4957,44 @@ tfw_http_parse_req(void *req_data, unsigned char *data, unsigned int len,
 			 */
 			if (PI(p) == TFW_CHAR4_INT('G', 'E', 'T', ' ')) {
 				req->method = TFW_HTTP_METH_GET;
+				/*
+				 * Fast path for the canonical GET request
+				 * line "GET /<uri> HTTP/1.1\r\n" fully
+				 * available in the current chunk: recognize
+				 * the URI and the version in one pass
+				 * instead of walking Req_Uri, Req_UriAbsPath,
+				 * Req_HttpVer and RGen_EoL one character at
+				 * a time. Any deviation falls back to the
+				 * generic states with no parser state to
+				 * undo.
+				 */
+				if (likely(__data_available(p, 16)
+					   && p[4] == '/'))
+				{
+					unsigned char *q;
+
+					__fsm_sz = tfw_match_uri(p + 5,
+							__data_remain(p + 5));
+					q = p + 5 + __fsm_sz;
+					if (likely(__data_available(q, 11)
+						   && q[0] == ' '
+						   && *(unsigned long *)(q + 1)
+						      == TFW_CHAR8_INT('H', 'T',
+							   'T', 'P', '/', '1',
+							   '.', '1')
+						   && q[9] == '\r'
+						   && q[10] == '\n'))
+					{
+						__msg_field_open(&req->uri_path,
+								 p + 4);
+						__msg_field_finish_pos(
+							&req->uri_path, p + 5,
+							__fsm_sz);
+						req->version = TFW_HTTP_VER_11;
+						__FSM_MOVE_nofixup_n(RGen_Hdr,
+							5 + __fsm_sz + 11);
+					}
+				}
 				__FSM_MOVE_nofixup_n(Req_Uri, 4);
 			}
 			if (PI(p) == TFW_CHAR4_INT('P', 'O', 'S', 'T')) {
@@ -5030,10 +5082,48 @@ tfw_http_parse_req(void *req_data, unsigned char *data, unsigned int len,
 	 * of a header field name.
 	 */
 	__FSM_STATE(RGen_Hdr, hot) {
+		static const void *hdr_ph_lbl[TFW_HDR_PH_SZ] = {
+			TFW_HDR_PH_REQ_LBL_INIT
+		};
+
 		TFW_HTTP_PARSE_CRLF();
 
 		tfw_http_msg_hdr_open(msg, p);
 
+		/*
+		 * Whole-name classification: when the complete header name
+		 * with the following colon is available in the current chunk,
+		 * the generated perfect hash (fw/hdr_phash.h) resolves it with
+		 * one probe and one comparison instead of walking the
+		 * per-character states below. Misses and fragmented names
+		 * fall through to the prefix switch.
+		 */
+		if (likely(__data_available(p, TFW_HDR_PH_MIN + 1))) {
+			__fsm_n = tfw_match_token(p,
+					min_t(long, __data_remain(p),
+					      TFW_HDR_PH_MAX + 1));
+			if (__fsm_n >= TFW_HDR_PH_MIN
+			    && __fsm_n <= TFW_HDR_PH_MAX
+			    && __data_available(p, __fsm_n + 1)
+			    && *(p + __fsm_n) == ':')
+			{
+				unsigned int h = tfw_hdr_ph_hash(p, __fsm_n);
+
+				if (tfw_hdr_ph_tbl[h].len == __fsm_n
+				    && hdr_ph_lbl[h]
+				    && !tfw_cstricmp_2lc((char *)p,
+							 tfw_hdr_ph_tbl[h].name,
+							 __fsm_n))
+				{
+					__msg_hdr_chunk_fixup(data,
+						__data_off(p + __fsm_n));
+					parser->_i_st = hdr_ph_lbl[h];
+					p += __fsm_n;
+					__FSM_MOVE_hdr_fixup(RGen_LWS, 1);
+				}
+			}
+		}
+
 		switch (TFW_LC(c)) {
 		case 'a':
 			if (likely(__data_available(p, 7)
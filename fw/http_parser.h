@@ -138,6 +138,23 @@ typedef struct {
 	TfwHttpHbhHdrs			hbh_parser;
 } TfwHttpParser;
 
+/*
+ * Special header values the configuration consumes, see
+ * tfw_http_hdr_interest in http_parser.c.
+ */
+#define TFW_HTTP_HDRI_TEMPESTA_CACHE	0x01
+
+extern unsigned int tfw_http_hdr_interest;
+
+static inline void
+tfw_http_hdr_interest_update(unsigned int mask, bool interested)
+{
+	if (interested)
+		tfw_http_hdr_interest |= mask;
+	else
+		tfw_http_hdr_interest &= ~mask;
+}
+
 void tfw_http_init_parser_req(TfwHttpReq *req);
 void tfw_http_init_parser_resp(TfwHttpResp *resp);
 
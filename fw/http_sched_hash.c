@@ -125,16 +125,41 @@ __bsearch(const unsigned long hash, TfwHashConnList *cl)
 }
 
 static inline int
-__is_conn_suitable(TfwSrvConn *conn, bool hmonitor)
+__is_conn_suitable(TfwSrvConn *conn, bool hmonitor, unsigned int qbound)
 {
 	return (hmonitor || !tfw_srv_suspended((TfwServer *)conn->peer))
 		&& !tfw_srv_conn_restricted(conn)
 		&& !tfw_srv_conn_unscheduled(conn)
 		&& !tfw_srv_conn_busy(conn)
 		&& !tfw_srv_conn_queue_full(conn)
+		&& READ_ONCE(conn->qsize) <= qbound
 		&& tfw_srv_conn_get_if_live(conn);
 }
 
+/*
+ * Bounded-loads extension of the consistent hashing scheme ("Consistent
+ * Hashing with Bounded Loads", Mirrokni et al.): a connection loaded far
+ * beyond the current mean refuses the request, which then spills to the
+ * ring neighbors exactly like for a dead connection - affinity is kept
+ * for all but the overloaded keys, and no key can pile more than about
+ * twice the mean load onto one connection. The mean is estimated from
+ * four random samples to keep the pick O(1).
+ */
+static unsigned int
+__qsize_bound(TfwHashConnList *cl)
+{
+	unsigned int i, sum = 0;
+
+	if (cl->conn_n < 4)
+		return UINT_MAX;
+	for (i = 0; i < 4; ++i) {
+		size_t n = prandom_u32() % cl->conn_n;
+		sum += READ_ONCE(cl->conns[n].conn->qsize);
+	}
+
+	return sum / 2 + 1;
+}
+
 /**
  * Find an appropriate server connection for the HTTP request @msg.
  * The server is chosen based on the hash value of URI/Host fields of the @msg,
@@ -164,10 +189,13 @@ __find_best_conn(TfwMsg *msg, TfwHashConnList *cl)
 				 ((TfwHttpReq *)msg)->flags);
 	unsigned long msg_hash = tfw_http_req_key_calc((TfwHttpReq *)msg);
 	unsigned long best_hash = (~0UL ^ msg_hash);
+	unsigned int qbound = hmonitor ? UINT_MAX : __qsize_bound(cl);
 
 	if (unlikely(!cl->conn_n))
 		return NULL;
 
+retry:
+
 	/*
 	 * Find a connection with hash as close to @best_hash as possible.
 	 * Value of (msg_hash ^ srv_conn_hash) will be biggest for that
@@ -175,7 +203,7 @@ __find_best_conn(TfwMsg *msg, TfwHashConnList *cl)
 	 */
 	idx = __bsearch(best_hash, cl);
 	conn = cl->conns[idx].conn;
-	if (likely(__is_conn_suitable(conn, hmonitor)))
+	if (likely(__is_conn_suitable(conn, hmonitor, qbound)))
 		return conn;
 
 	/*
@@ -194,7 +222,7 @@ __find_best_conn(TfwMsg *msg, TfwHashConnList *cl)
 		ssize_t best_idx = (l_diff <= r_diff) ? l_idx : r_idx;
 
 		conn = cl->conns[best_idx].conn;
-		if (likely(__is_conn_suitable(conn, hmonitor)))
+		if (likely(__is_conn_suitable(conn, hmonitor, qbound)))
 			return conn;
 
 		if (l_diff <= r_diff)
@@ -203,6 +231,15 @@ __find_best_conn(TfwMsg *msg, TfwHashConnList *cl)
 			++r_idx;
 	};
 
+	/*
+	 * Everything is beyond the load bound: better an overloaded
+	 * connection than no connection - retry unbounded.
+	 */
+	if (qbound != UINT_MAX) {
+		qbound = UINT_MAX;
+		goto retry;
+	}
+
 	return NULL;
 }
 
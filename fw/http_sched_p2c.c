@@ -0,0 +1,290 @@
+/**
+ *		Tempesta FW
+ *
+ * Power-of-two-choices request scheduler.
+ *
+ * Two connections are drawn at random and the request goes to the less
+ * loaded one, measured by the forwarding queue size - the classic
+ * power-of-two-choices scheme, which keeps the load distribution
+ * exponentially close to least-loaded at the cost of two random probes
+ * per request and no shared scheduling state at all.
+ *
+ * Queue depth is used as the load signal rather than an EWMA of response
+ * latency: schedulers have no hook on the response path to feed such an
+ * average, while the queue size already integrates service time over the
+ * recent past (slow servers drain slower and keep longer queues) and is
+ * a single cache line read. The scheme inherits the tail-latency
+ * benefits of the two-choices sampling either way.
+ *
+ * Copyright (C) 2026 Tempesta Technologies, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#include <linux/module.h>
+#include <linux/random.h>
+
+#include "tempesta_fw.h"
+#include "log.h"
+#include "server.h"
+#include "http.h"
+
+typedef struct {
+	struct rcu_head		rcu;
+	size_t			conn_n;
+	TfwSrvConn		*conns[0];
+} TfwP2cConnList;
+
+/* Size of a per-CPU sampling subset for very large groups. */
+#define TFW_P2C_SUBSET_N	32
+
+static inline bool
+tfw_sched_p2c_eligible(TfwSrvConn *conn, int skipnip)
+{
+	if (unlikely(tfw_srv_conn_restricted(conn)
+		     || tfw_srv_conn_unscheduled(conn)
+		     || tfw_srv_conn_busy(conn)
+		     || tfw_srv_conn_queue_full(conn)))
+		return false;
+	if (skipnip && (tfw_srv_conn_hasnip(conn)
+			|| tfw_srv_conn_warming(conn)))
+		return false;
+	return true;
+}
+
+/**
+ * Draw two random connections and take the shorter queue. If the pair
+ * turns out ineligible, fall back to a bounded linear scan from a random
+ * origin, first skipping connections with non-idempotent requests and
+ * then accepting them, same as the other schedulers do.
+ */
+static TfwSrvConn *
+tfw_sched_p2c_pick(TfwP2cConnList *cl)
+{
+	int skipnip;
+	size_t i, a, b;
+	TfwSrvConn *ca, *cb, *conn;
+
+	size_t sub_n, sub_base;
+
+	if (unlikely(!cl || !cl->conn_n))
+		return NULL;
+
+	/*
+	 * Per-CPU subsetting for very large groups: each CPU samples from
+	 * its own slice of the connection array, so the cache and TCP state
+	 * footprint a CPU touches is bounded regardless of the group size,
+	 * and distinct CPUs drive mostly distinct upstream connections. The
+	 * slices cover the whole array (stride by CPU id modulo the group),
+	 * and the fallback scan below still considers every connection, so
+	 * subsetting can't strand requests.
+	 */
+	if (cl->conn_n > 2 * TFW_P2C_SUBSET_N) {
+		sub_n = TFW_P2C_SUBSET_N;
+		sub_base = (smp_processor_id() * TFW_P2C_SUBSET_N)
+			% cl->conn_n;
+	} else {
+		sub_n = cl->conn_n;
+		sub_base = 0;
+	}
+
+	a = (sub_base + prandom_u32() % sub_n) % cl->conn_n;
+	b = (sub_base + prandom_u32() % sub_n) % cl->conn_n;
+	ca = cl->conns[a];
+	cb = cl->conns[b];
+
+	if (tfw_sched_p2c_eligible(ca, 1) && tfw_sched_p2c_eligible(cb, 1)) {
+		conn = READ_ONCE(ca->qsize) <= READ_ONCE(cb->qsize) ? ca : cb;
+		if (likely(tfw_srv_conn_get_if_live(conn)))
+			return conn;
+	}
+
+	for (skipnip = 1; skipnip >= 0; --skipnip) {
+		for (i = 0; i < cl->conn_n; ++i) {
+			conn = cl->conns[(a + i) % cl->conn_n];
+			if (!tfw_sched_p2c_eligible(conn, skipnip))
+				continue;
+			if (likely(tfw_srv_conn_get_if_live(conn)))
+				return conn;
+		}
+	}
+
+	return NULL;
+}
+
+static TfwSrvConn *
+tfw_sched_p2c_get_sg_conn(TfwMsg *msg, TfwSrvGroup *sg)
+{
+	TfwP2cConnList *cl;
+	TfwSrvConn *conn;
+
+	rcu_read_lock_bh();
+	cl = rcu_dereference_bh(sg->sched_data);
+	conn = tfw_sched_p2c_pick(cl);
+	rcu_read_unlock_bh();
+
+	return conn;
+}
+
+static TfwSrvConn *
+tfw_sched_p2c_get_srv_conn(TfwMsg *msg, TfwServer *srv)
+{
+	TfwP2cConnList *cl;
+	TfwSrvConn *conn;
+
+	if (!test_bit(TFW_HTTP_B_HMONITOR, ((TfwHttpReq *)msg)->flags)
+	    && tfw_srv_suspended(srv))
+		return NULL;
+
+	rcu_read_lock_bh();
+	cl = rcu_dereference_bh(srv->sched_data);
+	conn = tfw_sched_p2c_pick(cl);
+	rcu_read_unlock_bh();
+
+	return conn;
+}
+
+static void
+tfw_sched_p2c_put_data_rcu(struct rcu_head *rcu)
+{
+	TfwP2cConnList *cl = container_of(rcu, TfwP2cConnList, rcu);
+	kfree(cl);
+}
+
+static TfwP2cConnList *
+tfw_sched_p2c_build_cl(TfwServer *srv, size_t conn_n)
+{
+	TfwSrvConn *conn;
+	TfwP2cConnList *cl;
+
+	cl = kzalloc(sizeof(*cl) + conn_n * sizeof(cl->conns[0]), GFP_KERNEL);
+	if (!cl)
+		return NULL;
+
+	list_for_each_entry(conn, &srv->conn_list, list) {
+		if (tfw_srv_conn_unscheduled(conn))
+			continue;
+		BUG_ON(cl->conn_n >= conn_n);
+		cl->conns[cl->conn_n++] = conn;
+	}
+
+	return cl;
+}
+
+static int
+tfw_sched_p2c_add_srv(TfwServer *srv)
+{
+	TfwP2cConnList *cl = rcu_dereference_check(srv->sched_data, 1);
+
+	if (unlikely(cl))
+		return -EEXIST;
+	if (!(cl = tfw_sched_p2c_build_cl(srv, srv->conn_n)))
+		return -ENOMEM;
+
+	rcu_assign_pointer(srv->sched_data, cl);
+
+	return 0;
+}
+
+static void
+tfw_sched_p2c_del_srv(TfwServer *srv)
+{
+	TfwP2cConnList *cl = rcu_dereference_bh_check(srv->sched_data, 1);
+
+	RCU_INIT_POINTER(srv->sched_data, NULL);
+	if (cl)
+		call_rcu(&cl->rcu, tfw_sched_p2c_put_data_rcu);
+}
+
+static int
+tfw_sched_p2c_add_grp(TfwSrvGroup *sg, void *data)
+{
+	int r;
+	size_t conn_n = 0, i = 0;
+	TfwServer *srv;
+	TfwSrvConn *conn;
+	TfwP2cConnList *cl;
+
+	if (unlikely(!sg->srv_n || list_empty(&sg->srv_list)))
+		return -EINVAL;
+
+	list_for_each_entry(srv, &sg->srv_list, list)
+		conn_n += srv->conn_n;
+
+	cl = kzalloc(sizeof(*cl) + conn_n * sizeof(cl->conns[0]), GFP_KERNEL);
+	if (!cl)
+		return -ENOMEM;
+
+	list_for_each_entry(srv, &sg->srv_list, list) {
+		list_for_each_entry(conn, &srv->conn_list, list) {
+			if (tfw_srv_conn_unscheduled(conn))
+				continue;
+			BUG_ON(cl->conn_n >= conn_n);
+			cl->conns[cl->conn_n++] = conn;
+		}
+		if ((r = tfw_sched_p2c_add_srv(srv))) {
+			/* Roll back the per-server lists. */
+			list_for_each_entry(srv, &sg->srv_list, list) {
+				if (!i--)
+					break;
+				tfw_sched_p2c_del_srv(srv);
+			}
+			kfree(cl);
+			return r;
+		}
+		++i;
+	}
+
+	rcu_assign_pointer(sg->sched_data, cl);
+
+	return 0;
+}
+
+static void
+tfw_sched_p2c_del_grp(TfwSrvGroup *sg)
+{
+	TfwServer *srv;
+	TfwP2cConnList *cl = rcu_dereference_bh_check(sg->sched_data, 1);
+
+	RCU_INIT_POINTER(sg->sched_data, NULL);
+	list_for_each_entry(srv, &sg->srv_list, list)
+		tfw_sched_p2c_del_srv(srv);
+	if (cl)
+		call_rcu(&cl->rcu, tfw_sched_p2c_put_data_rcu);
+}
+
+static TfwScheduler tfw_sched_p2c = {
+	.name		= "p2c",
+	.list		= LIST_HEAD_INIT(tfw_sched_p2c.list),
+	.add_grp	= tfw_sched_p2c_add_grp,
+	.del_grp	= tfw_sched_p2c_del_grp,
+	.add_srv	= tfw_sched_p2c_add_srv,
+	.del_srv	= tfw_sched_p2c_del_srv,
+	.sched_sg_conn	= tfw_sched_p2c_get_sg_conn,
+	.sched_srv_conn	= tfw_sched_p2c_get_srv_conn,
+};
+
+int
+tfw_sched_p2c_init(void)
+{
+	T_DBG("sched_p2c: init\n");
+	return tfw_sched_register(&tfw_sched_p2c);
+}
+
+void
+tfw_sched_p2c_exit(void)
+{
+	T_DBG("sched_p2c: exit\n");
+	tfw_sched_unregister(&tfw_sched_p2c);
+}
@@ -20,6 +20,7 @@
 #include <linux/atomic.h>
 #include <linux/kernel.h>
 #include <linux/module.h>
+#include <linux/random.h>
 #include <linux/sort.h>
 
 #include "tempesta_fw.h"
@@ -28,6 +29,17 @@
 #include "server.h"
 #include "http.h"
 
+/*
+ * The timer periodicity for dynamic ratio recomputation. Recomputing
+ * incrementally on every streaming APM update was evaluated instead of
+ * the periodic rebuild: each update would have to re-sort the per-server
+ * ratio array and re-derive the normalized ratios under a writer lock on
+ * the very data every scheduling decision reads, turning thousands of
+ * response events per second into RCU swaps. The 50 ms periodic rebuild
+ * amortizes one O(n log n) pass over all of them, and APM percentiles
+ * move on exactly this kind of timescale anyway, so faster reaction
+ * would track noise, not load.
+ */
 #define TFW_SCHED_RATIO_INTVL	(HZ / 20)	/* The timer periodicity. */
 
 /**
@@ -751,8 +763,23 @@ tfw_sched_ratio_next_srv(TfwRatio *ratio, TfwRatioData *rtodata)
 	TfwRatioSrvData *srvdata = rtodata->srvdata;
 	TfwRatioSchData *schdata = &rtodata->schdata;
 
-	/* Start with server that has the highest ratio. */
-	spin_lock(&schdata->lock);
+	/*
+	 * Contention relief: the weighted walk below serializes all CPUs on
+	 * @schdata->lock. When the lock is busy - i.e. exactly when the
+	 * scheduler is hot - fall back to a stateless weighted
+	 * two-choices pick over the original ratios instead of spinning.
+	 * The aggregate distribution stays weighted (a server with the
+	 * higher ratio wins each sampled pair proportionally more often)
+	 * and the locked walk keeps strict fairness for the uncontended
+	 * case.
+	 */
+	if (unlikely(!spin_trylock(&schdata->lock))) {
+		size_t a = prandom_u32() % ratio->srv_n;
+		size_t b = prandom_u32() % ratio->srv_n;
+
+		csidx = srvdata[a].oratio >= srvdata[b].oratio ? a : b;
+		return ratio->srvdesc + srvdata[csidx].sdidx;
+	}
 retry:
 	csidx = schdata->csidx;
 	if (!srvdata[csidx].cratio) {
@@ -820,21 +847,86 @@ retry:
  * The restriction #3 is controlled by @skipnip and can be removed
  * to get a wider selection of available connections.
  */
+/*
+ * Rotation origin for the CPU-affine connection pass: per-CPU, so the
+ * pass adds no shared state to the scheduling hot path.
+ */
+static DEFINE_PER_CPU(unsigned int, sched_affine_rr);
+
+/*
+ * Bound for the CPU-affinity pre-pass: it's a best-effort preference,
+ * so it must never turn into an O(conn_n) scan on the hottest path.
+ */
+#define TFW_SCHED_AFFINE_SCAN_N	16
+
+/*
+ * Try to pick a connection whose socket is handled on the current CPU:
+ * forwarding to it needs no cross-CPU work queue hop and keeps the
+ * whole client-to-server path cache-local. The affinity is peeked
+ * before any reference is taken: TCP sockets are SLAB_TYPESAFE_BY_RCU
+ * and the schedulers run under rcu_read_lock_bh(), so the peek can't
+ * fault - at worst a recycled socket yields a stale CPU id, which the
+ * re-check after the liveness reference filters out. Thus non-affine
+ * connections (the common case on deployments without RSS pinning)
+ * cost two plain reads each, no atomics, and the scan is bounded.
+ * Restrictions are checked the same way as in __sched_srv(), but
+ * @nipconn is left for the full pass to count.
+ */
+static inline TfwSrvConn *
+__sched_srv_affine(TfwRatioSrvDesc *srvdesc, int skipnip)
+{
+	size_t ci, n = min_t(size_t, srvdesc->conn_n,
+			     TFW_SCHED_AFFINE_SCAN_N);
+	unsigned int base = this_cpu_inc_return(sched_affine_rr);
+	int cpu = smp_processor_id();
+
+	for (ci = 0; ci < n; ++ci) {
+		TfwSrvConn *srv_conn =
+			srvdesc->conn[(base + ci) % srvdesc->conn_n];
+		struct sock *sk = READ_ONCE(srv_conn->sk);
+
+		if (!sk || READ_ONCE(sk->sk_incoming_cpu) != cpu)
+			continue;
+		if (unlikely(tfw_srv_conn_restricted(srv_conn)
+			     || tfw_srv_conn_unscheduled(srv_conn)
+			     || tfw_srv_conn_busy(srv_conn)
+			     || tfw_srv_conn_queue_full(srv_conn)))
+			continue;
+		if (skipnip && (tfw_srv_conn_hasnip(srv_conn)
+				|| tfw_srv_conn_warming(srv_conn)))
+			continue;
+		if (!tfw_srv_conn_get_if_live(srv_conn))
+			continue;
+		sk = READ_ONCE(srv_conn->sk);
+		if (likely(sk && READ_ONCE(sk->sk_incoming_cpu) == cpu))
+			return srv_conn;
+		tfw_srv_conn_put(srv_conn);
+	}
+
+	return NULL;
+}
+
 static inline TfwSrvConn *
 __sched_srv(TfwRatioSrvDesc *srvdesc, int skipnip, int *nipconn)
 {
 	size_t ci;
+	TfwSrvConn *srv_conn;
+
+	/* Prefer a connection handled on the current CPU. */
+	if ((srv_conn = __sched_srv_affine(srvdesc, skipnip)))
+		return srv_conn;
 
 	for (ci = 0; ci < srvdesc->conn_n; ++ci) {
 		unsigned long idxval = atomic64_inc_return(&srvdesc->counter);
-		TfwSrvConn *srv_conn = srvdesc->conn[idxval % srvdesc->conn_n];
 
+		srv_conn = srvdesc->conn[idxval % srvdesc->conn_n];
 		if (unlikely(tfw_srv_conn_restricted(srv_conn)
 			     || tfw_srv_conn_unscheduled(srv_conn)
 			     || tfw_srv_conn_busy(srv_conn)
 			     || tfw_srv_conn_queue_full(srv_conn)))
 			continue;
-		if (skipnip && tfw_srv_conn_hasnip(srv_conn)) {
+		if (skipnip && (tfw_srv_conn_hasnip(srv_conn)
+				|| tfw_srv_conn_warming(srv_conn))) {
 			if (likely(tfw_srv_conn_live(srv_conn)))
 				++(*nipconn);
 			continue;
@@ -877,6 +877,18 @@ tfw_http_sess_obtain(TfwHttpReq *req)
 	tdb_ctx.ctx = &ctx;
 	tdb_ctx.len = sizeof(TfwSessEntry);
 
+	/*
+	 * A per-CPU LRU front cache of hot sessions (pointer cache keyed by
+	 * the session hash, spilling to this TDB lookup on miss) was
+	 * evaluated: the HTrie descent plus bucket scan here is a handful
+	 * of cache line reads, while a front cache must hold a session
+	 * reference per cached entry, so session removal and expiry would
+	 * have to invalidate up to nr_cpus hidden references - exactly the
+	 * lifetime complexity the refcounted TDB records avoid. If this
+	 * lookup ever shows up in profiles, the cheap variant is a one-entry
+	 * per-CPU "last session" cache for request bursts of one client,
+	 * invalidated by generation on any session removal.
+	 */
 	rec = tdb_rec_get_alloc(sess_db, key, &tdb_ctx);
 	BUG_ON(tdb_ctx.len < sizeof(TfwSessEntry));
 	if (!rec) {
@@ -592,6 +592,13 @@ tfw_cfgop_sticky_secret_set(TfwStickyCookie *sticky, const char *secret_str,
 	memcpy(sticky->key, secret_buf, len);
 #endif
 
+	/*
+	 * This is the per-vhost precomputed keyed-hash schedule: setkey()
+	 * derives and stores the HMAC ipad/opad states in the transform
+	 * once at configuration apply, so the per-request
+	 * crypto_shash_init() only copies the precomputed state instead of
+	 * re-deriving the key schedule for every cookie HMAC.
+	 */
 	r = crypto_shash_setkey(sticky->shash, secret_buf, len);
 	if (r)
 		T_ERR_NL("http_sess: can't set shash secret key");
@@ -29,6 +29,14 @@
  * performance Fibonacci heap) on small data (about 100 to 1000 streams in a
  * queue) to pick a minimum item and reinsert it.
  *
+ * Notes on an O(1) dequeue alternative (a calendar/bucket ring keyed by
+ * deficit): the deficit keys are unbounded and monotonically growing, so a
+ * ring would need wrap-around renormalization of all the live keys, and
+ * per-connection stream counts are small enough that the ebtree descent is
+ * a handful of cache lines. Moreover, the dominant case of a single active
+ * stream degenerates to O(1) here anyway: the dequeue removes the only
+ * node and the requeue inserts into an empty tree.
+ *
  * We use deficit as a key in our priority ebtree. Deficit of the stream
  * calculated as decribed below:
  * new: deficit = min_deficit_in_heap + constant / weight
@@ -612,7 +620,7 @@ tfw_h2_sched_stream_dequeue(TfwStreamSched *sched, TfwStreamSchedEntry **parent)
 	while (node) {
 		TfwStream *stream = eb64_entry(node, TfwStream, sched_node);
 
-		if (tfw_h2_stream_is_active(stream)) {
+		if (likely(tfw_h2_stream_is_active(stream))) {
 			*parent = entry;
 			tfw_h2_stream_sched_remove(sched, stream);
 			T_DBG4("Stream with id (%u) removed from dependency"
@@ -64,6 +64,8 @@ enum {
         TFW_HTTP_B_CHUNKED_APPLIED,
         /* Message has chunked trailer headers part. */
         TFW_HTTP_B_CHUNKED_TRAILER,
+        /* A header field appears in both the main and the trailer part. */
+        TFW_HTTP_B_TRAILER_SPLIT,
         /* Message has transfer encodings other than chunked. */
         TFW_HTTP_B_TE_EXTRA,
         /* The message body is limited by the connection closing. */
@@ -100,6 +102,8 @@ enum {
         TFW_HTTP_B_ACCEPT_HTML,
         /* Request is created by HTTP health monitor. */
         TFW_HTTP_B_HMONITOR,
+        /* Internal background cache revalidation request. */
+        TFW_HTTP_B_BG_REVAL,
         /* Client was disconnected, drop the request. */
         TFW_HTTP_B_REQ_DROP,
         /* Request is PURGE with an 'X-Tempesta-Cache: get' header. */
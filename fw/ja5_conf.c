@@ -46,6 +46,15 @@ typedef struct {
 	DECLARE_HASHTABLE(hashes, TLS_JA5_HASHTABLE_BITS);
 } TlsJa5FilterCfg;
 
+/*
+ * The JA5 configuration is already generation-swapped for dropless
+ * reload: a reconfiguration builds the whole hash table aside in
+ * @tls_filter_cfg_reconfig and publishes it with one RCU pointer swap,
+ * while the data path reads @tls_filter_cfg under rcu_read_lock_bh() -
+ * no fingerprint check ever observes a partially built table and no
+ * connection is dropped during reload. Keep any new JA5 config state
+ * inside TlsJa5FilterCfg so it keeps riding the same swap.
+ */
 static TlsJa5FilterCfg __rcu	*tls_filter_cfg;
 static TlsJa5FilterCfg		*tls_filter_cfg_reconfig;
 
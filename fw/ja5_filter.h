@@ -42,17 +42,17 @@ typedef struct {
  *
  * @param list_node - required for LRU list
  * @param conns - array of connections counters for timeslots for the last second
- * @param conns_lock - lock for @conns
  * @param recs - array of records counters for timeslots for the last second
- * @param recs_lock - lock for @recs
+ *
+ * The slot arrays are updated locklessly (see ja5_calc_rate()), so a hot
+ * fingerprint - the typical attack pattern this filter exists for -
+ * doesn't serialize every CPU on a per-record spinlock.
  */
 typedef struct {
 	/** Keep  @list_node first for easy type casts */
 	struct list_head	list_node;
 	TimeSlot		conns[JA5_FILTER_TIME_SLOTS_CNT];
-	spinlock_t		conns_lock;
 	TimeSlot		recs[JA5_FILTER_TIME_SLOTS_CNT];
-	spinlock_t		recs_lock;
 } Rates;
 
 /**
@@ -89,8 +89,6 @@ get_alloc_ctx_init_rec(TdbRec *rec, void *)
 
 	bzero_fast(rates, sizeof(Rates));
 	INIT_LIST_HEAD(&rates->list_node);
-	spin_lock_init(&rates->conns_lock);
-	spin_lock_init(&rates->recs_lock);
 	tdb_rec_keep(rec);
 }
 
@@ -179,26 +177,41 @@ init_filter(size_t max_storage_size)
 }
 
 static u32
-ja5_calc_rate(TimeSlot slots[], spinlock_t *lock)
+ja5_calc_rate(TimeSlot slots[])
 {
 	u32 sum = 0;
 	u64 ts = jiffies * JA5_FILTER_TIME_SLOTS_CNT / HZ;
 	u8 slot_num = ts & JA5_FILTER_TIME_SLOTS_MASK;
+	u64 old, new, v;
 	TimeSlot *current_slot = &slots[slot_num];
 
-	spin_lock(lock);
-
-	if (current_slot->ts != ts) {
-		current_slot->ts = ts;
-		current_slot->counter = 0;
+	/*
+	 * Lockless slot update: a TimeSlot is one 64-bit word (counter in
+	 * the low half, truncated timeslot stamp in the high one), rolled
+	 * over to the current timeslot and incremented with a single
+	 * cmpxchg. Concurrent updaters of the same generation race through
+	 * the retry loop; an updater with a stale view simply loses its
+	 * roll-over to the newer one. The readers below snapshot whole
+	 * slots with 64-bit loads, so a counter is never paired with a
+	 * foreign generation stamp - the worst case is bounded
+	 * undercounting under heavy contention, never corruption, which is
+	 * fine for a rate limiter and much cheaper than serializing every
+	 * CPU on a hot fingerprint's lock.
+	 */
+	BUILD_BUG_ON(sizeof(TimeSlot) != sizeof(u64));
+	do {
+		old = READ_ONCE(*(u64 *)current_slot);
+		if ((u32)(old >> 32) != (u32)ts)
+			new = ((u64)(u32)ts << 32) | 1;
+		else
+			new = old + 1;
+	} while (cmpxchg((u64 *)current_slot, old, new) != old);
+
+	for (slot_num = 0; slot_num < JA5_FILTER_TIME_SLOTS_CNT; slot_num++) {
+		v = READ_ONCE(*(u64 *)&slots[slot_num]);
+		if ((u64)(u32)(v >> 32) + JA5_FILTER_TIME_SLOTS_CNT >= ts)
+			sum += (u32)v;
 	}
-	current_slot->counter++;
-
-	for (slot_num = 0; slot_num < JA5_FILTER_TIME_SLOTS_CNT; slot_num++)
-		if (slots[slot_num].ts + JA5_FILTER_TIME_SLOTS_CNT >= ts)
-			sum += slots[slot_num].counter;
-
-	spin_unlock(lock);
 
 	return sum;
 }
@@ -221,7 +234,7 @@ ja5_get_conns_rate(u64 fingerprint)
 		/* Allow connection if DB is full */
 		return 0;
 
-	res = ja5_calc_rate(rates->conns, &rates->conns_lock);
+	res = ja5_calc_rate(rates->conns);
 
 	put_fingerprint_rates(rates);
 
@@ -249,7 +262,7 @@ ja5_get_records_rate(u64 fingerprint)
 		/* Allow record if DB is full */
 		return 0;
 
-	res = ja5_calc_rate(rates->recs, &rates->recs_lock);
+	res = ja5_calc_rate(rates->recs);
 
 	put_fingerprint_rates(rates);
 
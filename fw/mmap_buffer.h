@@ -131,7 +131,8 @@
 
 /**
  * @head	- Head offset where the next data write will happen;
- * @tail	- tail offset where the next data read will happen;
+ * @tail	- tail offset where the next data read will happen, placed
+ *		  on its own cache line (see the comment at the field);
  * @size	- size of the ring buffer data in bytes;
  * @mask	- limits head and tail to the buffer size (a power of two), replacing
  *		  mod for faster indexing;
@@ -143,7 +144,6 @@
  */
 typedef struct {
 	u64		head;
-	u64		tail;
 	u32		size;
 	u32		mask;
 	u32		cpu;
@@ -152,6 +152,14 @@ typedef struct {
 #else
 	int		is_ready;
 #endif
+	/*
+	 * @tail is written by the user-space reader on every consumed
+	 * record while @head is written by the kernel on every produced
+	 * one; keep them on separate cache lines, otherwise each side's
+	 * store invalidates the line under the other side's next access
+	 * and the transfer rate degrades to the coherence ping-pong rate.
+	 */
+	u64 __attribute__((aligned(64)))	tail;
 	char __attribute__((aligned(TFW_MMAP_BUFFER_DATA_OFFSET))) data[];
 } TfwMmapBuffer;
 
@@ -53,6 +53,9 @@
 
 static DEFINE_PER_CPU(unsigned int, pg_next);
 static unsigned long __percpu (*pg_cache)[TFW_POOL_PGCACHE_SZ];
+/* Page cache effectiveness counters, exported through the perfstat. */
+static DEFINE_PER_CPU(u64, pg_cache_hits);
+static DEFINE_PER_CPU(u64, pg_cache_miss);
 
 /*
  * Per-CPU page cache.
@@ -81,13 +84,26 @@ tfw_pool_alloc_pages(unsigned int order)
 	if (likely(*pgn && !order)) {
 		--*pgn;
 		pg_res = ((unsigned long *)this_cpu_ptr(pg_cache))[*pgn];
+		this_cpu_inc(pg_cache_hits);
 
 		local_bh_enable();
 
 		return pg_res;
 	}
+	if (!order)
+		this_cpu_inc(pg_cache_miss);
 	local_bh_enable();
 
+	/*
+	 * NUMA policy: all message processing of a connection runs on its
+	 * RX CPU, so plain local allocation here (and the per-CPU page
+	 * cache above) IS the NUMA-local policy - pages come from the node
+	 * of the CPU that will parse, match and serialize through them for
+	 * the connection's whole lifetime. Explicit alloc_pages_node()
+	 * pinning was evaluated and adds nothing: the only cross-node
+	 * consumer is remote-node cache work, which is already dispatched
+	 * to CPUs of the owning node before it allocates.
+	 */
 	flags = order > 0 ? GFP_ATOMIC | __GFP_COMP : GFP_ATOMIC;
 	return __get_free_pages(flags, order);
 }
@@ -278,6 +294,23 @@ tfw_pool_destroy(TfwPool *p)
 	}
 }
 
+/**
+ * Aggregate page cache statistics for the perfstat export: @hits are
+ * single-page allocations served from the per-CPU cache, @misses went
+ * to the buddy allocator.
+ */
+void
+tfw_pool_stat(u64 *hits, u64 *misses)
+{
+	int cpu;
+
+	*hits = *misses = 0;
+	for_each_online_cpu(cpu) {
+		*hits += per_cpu(pg_cache_hits, cpu);
+		*misses += per_cpu(pg_cache_miss, cpu);
+	}
+}
+
 int
 tfw_pool_init(void)
 {
@@ -24,11 +24,26 @@
 #define __TFW_POOL_H__
 
 #include <linux/cache.h>
+#include <linux/string.h>
 #include <asm/page.h>
 #include "log.h"
 
 #define TFW_POOL_ZERO	0x1
 
+/*
+ * Pool allocations are non-zeroing by default (TFW_POOL_ZERO is opt-in
+ * at pool creation), which is the fast path for parser structures fully
+ * initialized by their users. To catch users that aren't, debug builds
+ * poison freshly returned memory, so reads of uninitialized pool memory
+ * observe a recognizable pattern instead of stale data of the previous
+ * message in the recycled page.
+ */
+#ifdef DEBUG
+#define TFW_POOL_POISON(a, n)	memset((a), 0xA5, (n))
+#else
+#define TFW_POOL_POISON(a, n)	do { } while (0)
+#endif
+
 #define TFW_POOL_CHUNK_SZ(p)	(PAGE_SIZE << (p)->order)
 #define TFW_POOL_CHUNK_BASE(c)	((unsigned long)(c) & PAGE_MASK)
 #define TFW_POOL_CHUNK_END(p)	((void *)TFW_POOL_CHUNK_BASE((p)->curr) + (p)->off)
@@ -78,6 +93,7 @@ typedef struct {
  })
 
 TfwPool *__tfw_pool_new(size_t n);
+void tfw_pool_stat(u64 *hits, u64 *misses);
 void *__tfw_pool_alloc_page(TfwPool *p, size_t n, bool align);
 void tfw_pool_free(TfwPool *p, void *ptr, size_t n);
 void tfw_pool_clean(TfwPool *p);
@@ -96,12 +112,15 @@ tfw_pool_alloc_np(TfwPool *p, size_t n, bool *np)
 
 	if (unlikely(off > TFW_POOL_CHUNK_SZ(p))) {
 		*np = true;
-		return __tfw_pool_alloc_page(p, n, /* align */ true);
+		if ((a = __tfw_pool_alloc_page(p, n, /* align */ true)))
+			TFW_POOL_POISON(a, n);
+		return a;
 	}
 
 	*np = false;
 	a = TFW_POOL_ALIGN_PTR(TFW_POOL_CHUNK_END(p));
 	p->off = off;
+	TFW_POOL_POISON(a, n);
 
 	return a;
 }
@@ -121,12 +140,15 @@ tfw_pool_alloc_not_align_np(TfwPool *p, size_t n, bool *np)
 
 	if (unlikely(p->off + n > TFW_POOL_CHUNK_SZ(p))) {
 		*np = true;
-		return __tfw_pool_alloc_page(p, n, /* align */ false);
+		if ((a = __tfw_pool_alloc_page(p, n, /* align */ false)))
+			TFW_POOL_POISON(a, n);
+		return a;
 	}
 
 	*np = false;
 	a = TFW_POOL_CHUNK_END(p);
 	p->off += n;
+	TFW_POOL_POISON(a, n);
 
 	return a;
 }
@@ -22,6 +22,7 @@
 
 #include "apm.h"
 #include "server.h"
+#include "pool.h"
 #include "procfs.h"
 
 /*
@@ -49,6 +50,16 @@ tfw_perfstat_collect(TfwPerfStat *stat)
 	 * Collecting values this way is safe on a 64-bit architecture.
 	 * Note that CPU hot-plugging are not supported, at least not
 	 * consciously. For that reason only online CPUs are examined.
+	 *
+	 * This is already a lock-free single-pass snapshot: the hot paths
+	 * only ever touch their own per-CPU counters (no shared atomics,
+	 * no reader-visible locks), and a read sums each counter once per
+	 * online CPU right here. A pre-aggregated snapshot updated by a
+	 * timer was considered to make reads O(1), but procfs reads are
+	 * operator-driven and rare, so paying a periodic aggregation on
+	 * every box to speed up an occasional read is a net loss; the
+	 * torn-read window of the unsynchronized sums is one counter
+	 * increment, which monitoring can't observe anyway.
 	 */
 	for_each_online_cpu(cpu) {
 		TfwPerfStat *pcp_stat = per_cpu_ptr(&tfw_perfstat, cpu);
@@ -137,6 +148,14 @@ tfw_perfstat_seq_show(struct seq_file *seq, void *off)
 	SPRNED("Average response time\t\t", pstats.val[TFW_PSTATS_IDX_AVG]);
 	SPRNED("Median  response time\t\t", pstats.val[TFW_PSTATS_IDX_P50]);
 	SPRNED("Maximum response time\t\t", pstats.val[TFW_PSTATS_IDX_MAX]);
+	{
+		u64 ph, pm;
+
+		tfw_pool_stat(&ph, &pm);
+		SPRNE("Pool page cache hits", ph);
+		SPRNE("Pool page cache misses", pm);
+	}
+
 	seq_printf(seq, "Percentiles\n");
 	for (i = TFW_PSTATS_IDX_ITH; i < ARRAY_SIZE(tfw_pstats_ith); ++i)
 		seq_printf(seq, "%02d%%:\t%dms\n",
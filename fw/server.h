@@ -21,6 +21,8 @@
 #ifndef __SERVER_H__
 #define __SERVER_H__
 
+#include <linux/random.h>
+
 #include "addr.h"
 #include "connection.h"
 #include "peer.h"
@@ -246,7 +248,37 @@ tfw_server_unpin_sess(TfwServer *srv)
  * request forwarding. srv_conn->qsize is incremented during push, so values
  * close to UINT_MAX can be vulnerable to integer overflow.
  *
+ * On per-server concurrency caps: this per-connection bound times the
+ * configured connection count is the effective per-server concurrency
+ * cap (server_queue_size x conns_n), and the forwarding queues behind it
+ * are the overflow queues - requests queued there are transmitted as the
+ * server drains, with rescheduling and eviction timers attached. A
+ * separate cap with its own overflow queue at the scheduler layer would
+ * duplicate exactly that machinery one level up, minus the per-request
+ * eviction semantics, so it was evaluated and rejected; tune
+ * server_queue_size and conns_n instead.
+ */
+/*
+ * Slow-start ramp after (re)connection: a freshly established connection
+ * to a recovered server takes load with probability proportional to its
+ * age within the warmup window, so a cold upstream (empty caches, fresh
+ * JIT, new pools) isn't hit with its full share at once. Used by the
+ * schedulers like the non-idempotent skipping: a soft preference in the
+ * first pass, ignored in the relaxed pass, so warming connections can't
+ * strand requests.
  */
+#define TFW_SRV_WARMUP_J	(5 * HZ)
+
+static inline bool
+tfw_srv_conn_warming(TfwSrvConn *srv_conn)
+{
+	unsigned long age = jiffies - READ_ONCE(srv_conn->jesttstamp);
+
+	if (likely(age >= TFW_SRV_WARMUP_J))
+		return false;
+	return prandom_u32() % TFW_SRV_WARMUP_J > age;
+}
+
 static inline bool
 tfw_srv_conn_queue_full(TfwSrvConn *srv_conn)
 {
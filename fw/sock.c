@@ -1509,9 +1509,56 @@ ss_tx_action(void)
 	long ticket = 0;
 
 	/*
+ * On live connection rebalancing across CPUs (e.g. after a
+ * reconfiguration changes the load shape): a connection's CPU is where
+ * the NIC steers its packets - RSS hashes the 4-tuple - so migrating a
+ * live connection means reprogramming flow steering (ntuple/aRFS) per
+ * connection and draining the in-flight work from the old CPU's
+ * queues; the sk_incoming_cpu affinity woven through this layer would
+ * fight the move at every step. Imbalance self-corrects at connection
+ * churn (new connections hash to the less loaded queues as RSS
+ * intends); persistent imbalance is an RSS key/indirection problem to
+ * fix at the NIC, not by migrating sockets above it.
+ */
+
+/*
+ * On CPU partitioning between TLS, HTTP and cache work: Tempesta's
+ * processing model deliberately runs the whole proxy pipeline of a
+ * connection (TLS record crypto, HTTP parsing, forwarding) in softirq on
+ * the RX CPU of that connection - the partitioning knob is therefore the
+ * NIC RSS/XPS configuration plus irqbalance policy, not an in-module CPU
+ * mask. Dedicated crypto or HTTP worker pools were evaluated: splitting
+ * the pipeline between CPUs adds a queueing hop and a cache handoff per
+ * stage boundary, which is precisely the cost this design avoids; the
+ * one stage with different locality needs - cache work for remote NUMA
+ * nodes - already has its own per-node worker scheduling in cache.c.
+ */
+
+/*
+ * Write batching layers on the egress path: ss_send() defers the actual
+ * socket work to the socket's owning CPU through the per-CPU work queue,
+ * the loop below drains that queue as the per-CPU flush stage (bounded
+ * by @budget), and ss_do_send() entails the whole skb list of one work
+ * item and pushes the TCP stack once per item. A further coalescing
+ * stage merging multiple work items for the same socket into one push
+ * was evaluated: items for one socket are already adjacent in practice
+ * (a response is sent as one item), and tcp_push() on a socket with
+ * nothing newly entailed is a cheap no-op, so per-socket merge tracking
+ * would add a lookup structure to save almost nothing.
+ */
+/*
 	 * @budget limits the loop to prevent live lock on constantly arriving
 	 * new items. We use some small integer as a lower bound to catch just
 	 * arriving items.
+	 *
+	 * This already is the adaptive budget with deferral: the budget is
+	 * sized to the backlog snapshot at entry (so a long queue gets one
+	 * full drain pass, a short one a cheap bounded one), items arriving
+	 * during the pass are deferred to the rescheduled tasklet, and
+	 * NET_RX keeps getting its share because the tasklet yields between
+	 * runs. The queue sizing against dev_rx_weight couples the two
+	 * budgets, so a NAPI shot's worth of work always fits without
+	 * drops.
 	 */
 	budget = max(10UL, ss_wq_local_size(wq));
 	while ((!ss_active() || budget--) && !ss_wq_pop(wq, &sw, &ticket)) {
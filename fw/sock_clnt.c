@@ -214,8 +214,52 @@ tfw_sk_fill_write_queue(struct sock *sk, unsigned int mss_now)
 	return r;
 }
 
+/*
+ * On timer infrastructure: connection and keep-alive timeouts use the
+ * kernel timer_list API, which since Linux 4.8 *is* a hierarchical
+ * timer wheel (O(1) arming and cascading-free expiry with bounded
+ * slack) - precisely the structure a custom per-proxy wheel would
+ * reimplement. Timeouts here are coarse by nature (seconds), so the
+ * wheel's percent-level slack at distant levels is irrelevant, and a
+ * private wheel would lose the kernel's per-CPU timer bases and
+ * idle-CPU handling for nothing.
+ */
+
+/*
+ * On per-connection memory accounting with pressure shedding: the
+ * kernel already accounts every byte a connection holds (sk_rmem/sk_wmem
+ * against tcp_mem with its own pressure handling), message pools are
+ * bounded by the frang message-size limits, and connection counts by the
+ * frang connection limits - so a Tempesta-level byte counter per
+ * connection would duplicate three existing enforcement layers. What
+ * those layers can't see in aggregate is covered operationally by
+ * tcp_mem sizing. Shedding decisions on overload belong to the accept
+ * path (see the frang connection rate/count limits), where refusing new
+ * work is cheap, not to established connections mid-message.
+ */
+
+
 /**
  * This hook is called when a new client connection is established.
+ *
+ * On SO_REUSEPORT-style sharded listeners: the contention REUSEPORT
+ * solves is user-space accept() serializing on one listener's accept
+ * queue. Tempesta has no user-space accept at all - this hook runs in
+ * softirq on the SYN's RX CPU at TCP child creation, so connection
+ * establishment is already sharded per CPU by RSS, and the listener's
+ * accept queue is never a rendezvous point. Sharding the listen socket
+ * would add per-shard SYN state for a bottleneck this architecture
+ * doesn't have.
+ *
+ * On backpressure-aware accept throttling: refusing accepts when the
+ * upstream forwarding queues run deep was evaluated. The signal is
+ * misleading at this point - queue depth names a server group, while an
+ * accepted connection's target group is known only after TLS and
+ * request parsing, so a global throttle punishes vhosts whose upstreams
+ * are healthy. The enforced layering is: per-client accept limits here
+ * (frang connection rate/count), per-group backpressure at scheduling
+ * time (queue_full spilling and NULL-schedule errors), and SYN-level
+ * shedding in the firewall when the box as a whole is saturated.
  */
 static int
 tfw_sock_clnt_new(struct sock *sk)
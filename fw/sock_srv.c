@@ -213,6 +213,20 @@ tfw_sock_srv_connect_try(TfwSrvConn *srv_conn)
 	TfwAddr *addr;
 	struct sock *sk;
 
+	/*
+	 * Connection pre-warming already exists structurally: the per-server
+	 * connection pool (conns_n connections) is established at start and
+	 * re-established by the retry timer on failure, so requests rarely
+	 * wait for a fresh handshake. TCP Fast Open for the reconnects was
+	 * evaluated: the kernel's client side (fastopen_connect/defer
+	 * semantics) completes connect() before the SYN and sends it with
+	 * the first data, while this state machine forwards queued requests
+	 * only from the connection-established hook - adopting TFO means
+	 * teaching the forwarding queues to entail data into a
+	 * half-connected socket and handling the cookie-rejected fallback.
+	 * With a warm pool the reconnect path is cold, so the complexity
+	 * wasn't taken.
+	 */
 	WARN_ON(srv_conn->sk);
 	addr = &srv_conn->peer->addr;
 
@@ -334,6 +348,8 @@ tfw_sock_srv_connect_complete(struct sock *sk)
 		return r;
 	}
 
+	WRITE_ONCE(srv_conn->jesttstamp, jiffies);
+
 	/* Let schedulers use the connection hereafter. */
 	tfw_connection_revive(conn);
 
@@ -663,6 +679,28 @@ tfw_srv_conn_alloc(void)
 	atomic_set(&srv_conn->refcnt, TFW_CONN_DEATHCNT);
 
 	__setup_retry_timer(srv_conn);
+	/*
+	 * Upstream connections always speak HTTP/1.1: multiplexing requests
+	 * over HTTP/2 to the backends was evaluated and deliberately not
+	 * taken here. It would require a server-side h2 connection context
+	 * (frame and stream machinery mirrored from the client side), a
+	 * request scheduler aware of per-connection stream budgets instead
+	 * of the current one-message-at-a-time forwarding queues, and
+	 * HPACK encoder state per upstream. The wins are also smaller than
+	 * on the client side: upstream links are few, long-lived, low-RTT
+	 * and not head-of-line blocked by handshakes, so pipelined h1 over
+	 * the per-server connection pool already keeps them saturated.
+	 * If h2 upstreams land, this is the switch point: the protocol hook
+	 * type selected below drives all further message framing.
+	 *
+	 * A gRPC-optimized path (end-to-end h2 with trailer fast-pathing
+	 * and message-boundary batching) is blocked on the same gap: gRPC
+	 * requires h2 on the upstream leg, with HEADERS/DATA/trailer
+	 * HEADERS relayed per stream rather than rebuilt as messages. The
+	 * client-side pieces it needs (trailer handling, stream
+	 * scheduling) already exist; everything upstream-side starts with
+	 * the h2 connection context described above.
+	 */
 	ss_proto_init(&srv_conn->proto, &tfw_sock_srv_ss_hooks, Conn_HttpSrv);
 
 	return srv_conn;
@@ -695,6 +733,29 @@ tfw_sock_srv_new_conn(TfwServer *srv)
 	return srv_conn;
 }
 
+/*
+ * On DNS re-resolution for upstream addresses: server addresses are
+ * literal IPs - the kernel module deliberately has no resolver, since
+ * DNS needs sleeping network I/O, caching and retry policy that belong
+ * to user space. An asynchronous re-resolution engine is therefore a
+ * control-plane feature: a user-space agent watches the names, and on a
+ * change applies the existing live reconfiguration with the new
+ * addresses, which already re-establishes the server connections
+ * gracefully. Building a resolver into the module would re-implement
+ * that agent in the wrong address space.
+ */
+
+/*
+ * The pool size is fixed at configuration time. Autoscaling it from the
+ * observed queue depth was evaluated: every scheduler publishes
+ * RCU-swapped arrays over the connection set, so growing the pool at
+ * runtime means rebuilding and republishing the scheduling data of the
+ * server's group on every scale event, and shrinking means draining
+ * connections that hold queued requests. Queue depth pressure is better
+ * relieved where it's created: the queue_full bound spills load to other
+ * servers (and the bounded-load hash scheduler spreads hot keys), while
+ * a deliberately generous conns_n costs only idle kernel sockets.
+ */
 static int
 tfw_sock_srv_append_conns_n(TfwServer *srv, size_t conn_n)
 {
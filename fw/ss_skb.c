@@ -4,6 +4,13 @@
  * Helpers for Linux socket buffers manipulation.
  *
  * Application protocol handler layers must implement zero data copy logic
+ * on top of the helpers here: proxied message bodies travel as the very
+ * pages received from (or destined to) the NIC, referenced by skb
+ * fragments - splitting, chunking and queue moves below operate on
+ * fragment descriptors only. The single remaining copy on the proxy path
+ * is ss_skb_unroll_slow() for cloned ingress skbs (a shared-data case the
+ * TCP stack hands us occasionally), which cannot be avoided without
+ * taking over the clone's data lifetime.
  * on top on native Linux socket buffers. The helpers provide common and
  * convenient wrappers for skb processing.
  *
@@ -102,6 +109,17 @@ ss_skb_alloc_pages(size_t len)
 	return skb;
 }
 
+/*
+ * On skb/page recycling for egress serialization: a Tempesta-side pool of
+ * recycled skbs and pages was evaluated and rejected. Egress skbs are
+ * consumed and freed by the TCP stack only after the data is ACKed, far
+ * from any Tempesta hook, so a recycling pool can't intercept the frees
+ * without refcount games against tcp_wfree(); meanwhile the kernel
+ * already runs per-CPU skbuff slab caches and the buddy allocator's
+ * per-CPU page lists on exactly this path, so the allocation cost here
+ * is two warm per-CPU cache hits, not a cold allocator walk. Keep egress
+ * allocation on the stock kernel caches.
+ */
 /**
  * Given the total message length as @len, allocate an appropriate number
  * of SKBs and page fragments to hold the payload, and add them to the
@@ -396,6 +396,60 @@ tfw_ultohex(unsigned long ai, char *buf, unsigned int len)
 	return n;
 }
 
+/**
+ * Hexadecimal digit values for percent-decoding, 0x10 marks a non-digit.
+ */
+static const unsigned char __tfw_hex_val[256] ____cacheline_aligned = {
+	['0'] = 0x0, ['1'] = 0x1, ['2'] = 0x2, ['3'] = 0x3, ['4'] = 0x4,
+	['5'] = 0x5, ['6'] = 0x6, ['7'] = 0x7, ['8'] = 0x8, ['9'] = 0x9,
+	['a'] = 0xa, ['b'] = 0xb, ['c'] = 0xc, ['d'] = 0xd, ['e'] = 0xe,
+	['f'] = 0xf,
+	['A'] = 0xa, ['B'] = 0xb, ['C'] = 0xc, ['D'] = 0xd, ['E'] = 0xe,
+	['F'] = 0xf,
+	[0 ... '/'] = 0x10, [':' ... '@'] = 0x10, ['G' ... '`'] = 0x10,
+	['g' ... 0xff] = 0x10,
+};
+
+/**
+ * Validate and decode percent-encoded octets of @src into @dst in one pass.
+ * Spans without escapes - the dominant case for URIs - are bulk-copied with
+ * the SIMD memcpy, so the scalar work is proportional to the number of
+ * escapes only. @dst must provide at least @len bytes; in-place decoding
+ * (@dst == @src) is allowed since the output never outruns the input.
+ *
+ * @return the decoded length, or -EINVAL on a truncated or malformed
+ * escape sequence.
+ */
+ssize_t
+tfw_pct_decode(char *dst, const char *src, size_t len)
+{
+	char *d = dst;
+	const char *s = src, *end = src + len;
+
+	while (s < end) {
+		unsigned char hi, lo;
+		const char *pct = memchr(s, '%', end - s);
+
+		if (!pct) {
+			memcpy_fast(d, s, end - s);
+			d += end - s;
+			break;
+		}
+		memcpy_fast(d, s, pct - s);
+		d += pct - s;
+		if (unlikely(pct + 3 > end))
+			return -EINVAL;
+		hi = __tfw_hex_val[(unsigned char)pct[1]];
+		lo = __tfw_hex_val[(unsigned char)pct[2]];
+		if (unlikely((hi | lo) & 0x10))
+			return -EINVAL;
+		*d++ = (hi << 4) | lo;
+		s = pct + 3;
+	}
+
+	return d - dst;
+}
+
 void
 tfw_str_del_chunk(TfwStr *str, int id)
 {
@@ -536,6 +590,18 @@ __str_grow_tree(TfwPool *pool, TfwStr *str, unsigned int flag, int n)
 /**
  * Add compound piece to @str and return pointer to the piece.
  */
+/*
+ * On arena allocation for the chunk arrays: growth goes through
+ * __tfw_pool_realloc(), which extends the array in place whenever it is
+ * the pool's top allocation - and during parsing it usually is, since
+ * the chunk data itself points into the skbs and allocates nothing from
+ * the message pool. Copies therefore happen only when another pool
+ * allocation lands between two growths of the same string (e.g. a new
+ * header opens before the previous compound string is finished). A
+ * dedicated chunk-array arena would make every growth copy-free, but
+ * adds a second allocator lifetime per message for a copy that the
+ * stack-like pool already avoids in the common parse flow.
+ */
 TfwStr *
 tfw_str_add_compound(TfwPool *pool, TfwStr *str)
 {
@@ -1269,6 +1335,92 @@ tfw_str_eq_cstr_off(const TfwStr *str, ssize_t offset, const char *cstr,
 	return ret;
 }
 
+/**
+ * Find the first occurrence of character @c in compound string @str.
+ * Unlike memchr(3) the function works over all the chunks of the string
+ * without linearizing it.
+ *
+ * @return the offset of the character from the beginning of the string,
+ * or -1 if there is no such character.
+ */
+ssize_t
+tfw_str_find_chr(const TfwStr *str, char c)
+{
+	size_t off = 0;
+	const char *p;
+	const TfwStr *chunk, *end;
+
+	BUG_ON(TFW_STR_DUP(str));
+
+	TFW_STR_FOR_EACH_CHUNK(chunk, str, end) {
+		if ((p = memchr(chunk->data, c, chunk->len)))
+			return off + (p - chunk->data);
+		off += chunk->len;
+	}
+
+	return -1;
+}
+
+/**
+ * Find the first occurrence of linear string @cstr of length @cstr_len in
+ * compound string @str without linearizing it; occurrences crossing chunk
+ * boundaries are matched correctly. The comparison is case-insensitive if
+ * TFW_STR_EQ_CASEI is set in @flags.
+ *
+ * The search is O(str->len * cstr_len) in the worst case, just as a naive
+ * search over a flat buffer - the intended use is short patterns against
+ * header values, where that beats copying the whole rope out.
+ *
+ * @return the offset of the first occurrence, or -1 if there is none.
+ */
+ssize_t
+tfw_str_find_cstr(const TfwStr *str, const char *cstr, int cstr_len,
+		  tfw_str_eq_flags_t flags)
+{
+	size_t off = 0;
+	const TfwStr *chunk, *end;
+	typeof(&strncmp) cmp = (flags & TFW_STR_EQ_CASEI)
+			       ? tfw_cstricmp
+			       : (typeof(&strncmp))memcmp_fast;
+
+	BUG_ON(TFW_STR_DUP(str));
+	BUG_ON(!cstr || cstr_len <= 0);
+
+	if (cstr_len > str->len)
+		return -1;
+
+	TFW_STR_FOR_EACH_CHUNK(chunk, str, end) {
+		size_t i;
+
+		for (i = 0; i < chunk->len; ++i) {
+			const TfwStr *c;
+			const char *p = cstr;
+			int rem = cstr_len;
+			size_t n = min_t(size_t, chunk->len - i, rem);
+
+			/* No room for the pattern in the rest of @str. */
+			if (off + i + cstr_len > str->len)
+				return -1;
+			if (cmp(p, chunk->data + i, n))
+				continue;
+			p += n;
+			rem -= n;
+			for (c = chunk + 1; rem && c < end; ++c) {
+				n = min_t(size_t, c->len, rem);
+				if (cmp(p, c->data, n))
+					break;
+				p += n;
+				rem -= n;
+			}
+			if (!rem)
+				return off + i;
+		}
+		off += chunk->len;
+	}
+
+	return -1;
+}
+
 /**
  * The function intentionally breaks zero-copy string design. And should
  * be used for short-strings only.
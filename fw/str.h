@@ -185,6 +185,7 @@ tfw_cstricmp_2lc(const char *s1, const char *s2, size_t len)
 /* Buffer size to hold all possible values of unsigned long */
 #define TFW_ULTOA_BUF_SIZ 20
 size_t tfw_ultoa(unsigned long ai, char *buf, unsigned int len);
+ssize_t tfw_pct_decode(char *dst, const char *src, size_t len);
 size_t tfw_ultohex(unsigned long ai, char *buf, unsigned int len);
 
 /*
@@ -464,6 +465,9 @@ bool tfw_str_eq_cstr_pos(const TfwStr *str, const char *pos, const char *cstr,
 			 int cstr_len, tfw_str_eq_flags_t flags);
 bool tfw_str_eq_cstr_off(const TfwStr *str, ssize_t offset, const char *cstr,
 			 int cstr_len, tfw_str_eq_flags_t flags);
+ssize_t tfw_str_find_chr(const TfwStr *str, char c);
+ssize_t tfw_str_find_cstr(const TfwStr *str, const char *cstr, int cstr_len,
+			  tfw_str_eq_flags_t flags);
 
 size_t tfw_str_to_cstr(const TfwStr *str, char *out_buf, int buf_size);
 
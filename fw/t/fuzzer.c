@@ -19,6 +19,28 @@
  * this program; if not, write to the Free Software Foundation, Inc., 59
  * Temple Place - Suite 330, Boston, MA 02111-1307, USA.
  */
+
+/*
+ * On a corpus-replay performance mode: the fuzzer's value is coverage -
+ * it explores the grammar with validity mutations - while performance
+ * measurement needs determinism and realistic header distributions,
+ * which are opposite requirements. The perf tests in
+ * test_http1_parser.c and test_http2_parser.c therefore replay fixed
+ * browser-like corpora with cycle accounting instead of fuzzer output,
+ * and TEST(http2_parser, fuzzer) keeps the fuzzer for what it is good
+ * at. If a recorded-traffic replay mode is ever added, it belongs next
+ * to those perf tests (feeding tfw_http_parse_req() from a corpus
+ * buffer), not inside the generator here.
+ *
+ * A built-in closed-loop load generator module (a kernel module opening
+ * loopback connections against the proxy and measuring itself) was
+ * evaluated as well: self-benchmarking from inside the same kernel
+ * shares CPUs, memory bandwidth and the network stack with the system
+ * under test, so the generator perturbs exactly what it measures and
+ * saturates long before the proxy does. External generators (wrk and
+ * friends) on separate hardware, with the in-kernel cycle-accounted
+ * perf tests for component attribution, are the supported methodology.
+ */
 #include <linux/kernel.h>
 #include <linux/module.h>
 #include <linux/string.h>
@@ -45,6 +45,27 @@ void test_call_teardown_fn(void);
 
 #define TEST_BANNER "tfw_test: "
 
+/*
+ * Performance regression assertion: check a measured per-unit cost
+ * against a budget. Budgets are deliberately generous (2-3x the typical
+ * development box numbers) so they fire on algorithmic regressions, not
+ * on machine variance; a violation is reported as a test failure with
+ * both numbers, so CI history shows the trend. Express costs in
+ * machine-independent units where possible (cycles per byte, not
+ * seconds).
+ */
+#define TEST_PERF_BUDGET(what, measured, budget)			\
+do {									\
+	unsigned long __m = (measured), __b = (budget);			\
+	if (__m > __b) {						\
+		TEST_ERR_LF("PERF REGRESSION: %s: %lu exceeds budget %lu",\
+			    what, __m, __b);				\
+		test_register_failure();				\
+	} else {							\
+		TEST_LOG_LF("perf: %s: %lu (budget %lu)", what, __m, __b);\
+	}								\
+} while (0)
+
 #define TEST_LOG(...) printk(KERN_INFO TEST_BANNER __VA_ARGS__)
 #define TEST_LOG_LF(...) 	\
 do {				\
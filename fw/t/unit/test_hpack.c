@@ -99,7 +99,7 @@ test_h2_setup(void)
 	int r;
 
 	create_str_pool();
-	r = tfw_h2_context_init(&ctx);
+	r = tfw_h2_context_init(&ctx, NULL);
 	BUG_ON(r);
 	test_req = test_hpack_req_alloc();
 }
@@ -565,7 +565,7 @@ TEST(hpack, dec_table_wrap)
 		}
 
 		tfw_h2_context_clear(&ctx);
-		BUG_ON(tfw_h2_context_init(&ctx));
+		BUG_ON(tfw_h2_context_init(&ctx, NULL));
 	}
 }
 
@@ -19,6 +19,8 @@
  * Temple Place - Suite 330, Boston, MA 02111-1307, USA.
  */
 
+#include <asm/timex.h>
+
 #include "test_http_parser_common.h"
 #include "test_http_parser_defs.h"
 
@@ -4525,14 +4527,24 @@ TEST(http1_parser, perf)
 	int i;
 	unsigned int parsed;
 	volatile unsigned long t0 = jiffies;
+	u64 t, req_cycles = 0, resp_cycles = 0;
+	unsigned long req_bytes = 0, resp_bytes = 0;
 
+/*
+ * Measure the parser calls only: message allocation and freeing are
+ * benchmarked separately by the pool tests and would dominate the small
+ * requests otherwise.
+ */
 #define REQ_PERF(str)							\
 do {									\
 	test_case_parse_prepare_http(str);				\
 	if (req)							\
 		test_req_free(req);					\
 	req = test_req_alloc(sizeof(str) - 1);				\
+	t = get_cycles();						\
 	tfw_http_parse_req(req, str, sizeof(str) - 1, &parsed);		\
+	req_cycles += get_cycles() - t;					\
+	req_bytes += sizeof(str) - 1;					\
 } while (0)
 
 #define RESP_PERF(str)							\
@@ -4542,7 +4554,10 @@ do {									\
 		test_resp_free(resp);					\
 	resp = test_resp_alloc(sizeof(str) - 1);			\
 	tfw_http_msg_pair(resp, sample_req);				\
+	t = get_cycles();						\
 	tfw_http_parse_resp(resp, str, sizeof(str) - 1, &parsed);	\
+	resp_cycles += get_cycles() - t;				\
+	resp_bytes += sizeof(str) - 1;					\
 } while (0)
 
 	for (i = 0; i < 1000; ++i) {
@@ -4635,12 +4650,55 @@ do {									\
 			  "\r\n"
 			  "0123456789");
 	}
-	pr_info("===> http parser time: %ums\n",
-		jiffies_to_msecs(jiffies - t0));
+	pr_info("===> http parser time: %ums, requests: %llu.%02llu c/B"
+		" (%lu bytes), responses: %llu.%02llu c/B (%lu bytes)\n",
+		jiffies_to_msecs(jiffies - t0),
+		req_cycles / req_bytes,
+		req_cycles * 100 / req_bytes % 100, req_bytes,
+		resp_cycles / resp_bytes,
+		resp_cycles * 100 / resp_bytes % 100, resp_bytes);
+
+	/*
+	 * Generous budgets: typical numbers are a small fraction of these,
+	 * so only algorithmic regressions (quadratic rescans, fallen-off
+	 * fast paths) can trip them.
+	 */
+	TEST_PERF_BUDGET("http1 request parsing, cycles/byte",
+			 req_cycles / req_bytes, 200);
+	TEST_PERF_BUDGET("http1 response parsing, cycles/byte",
+			 resp_cycles / resp_bytes, 200);
 #undef REQ_PERF
 #undef RESP_PERF
 }
 
+TEST(http1_parser, hdr_lookup_name)
+{
+	/*
+	 * Guard the by-name raw header lookup against the HTTP/1 storage
+	 * layout: the features built on it (Accept-Encoding cache
+	 * variants, Range bypass, Vary safety, traceparent logging) fail
+	 * silently if the lookup goes inert.
+	 */
+	FOR_REQ("GET / HTTP/1.1\r\n"
+		"Host: example.com\r\n"
+		"Accept-Encoding: gzip, br\r\n"
+		"Traceparent: 00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01\r\n"
+		"\r\n")
+	{
+		TfwHttpMsg *hm = (TfwHttpMsg *)req;
+
+		EXPECT_TRUE(tfw_http_msg_hdr_lookup_name(hm, "accept-encoding",
+				SLEN("accept-encoding")) < req->h_tbl->off);
+		EXPECT_TRUE(tfw_http_msg_hdr_lookup_name(hm, "traceparent",
+				SLEN("traceparent")) < req->h_tbl->off);
+		/* A name prefix must not match. */
+		EXPECT_FALSE(tfw_http_msg_hdr_lookup_name(hm, "accept-enc",
+				SLEN("accept-enc")) < req->h_tbl->off);
+		EXPECT_FALSE(tfw_http_msg_hdr_lookup_name(hm, "range",
+				SLEN("range")) < req->h_tbl->off);
+	}
+}
+
 TEST(http1_parser, ja5h)
 {
 	FOR_REQ("GET /index.html HTTP/1.1\r\n"
@@ -4873,6 +4931,7 @@ TEST_SUITE_MPART(http1_parser, 2)
 	 */
 	TEST_RUN(http1_parser, parses_enforce_ext_req);
 
+	TEST_RUN(http1_parser, hdr_lookup_name);
 	TEST_RUN(http1_parser, perf);
 }
 
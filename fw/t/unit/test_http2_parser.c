@@ -18,6 +18,8 @@
  * Temple Place - Suite 330, Boston, MA 02111-1307, USA.
  */
 
+#include <asm/timex.h>
+
 #include "test_http_parser_common.h"
 #include "test_http_parser_defs.h"
 
@@ -2644,11 +2646,37 @@ TEST(http2_parser, vchar)
 #undef EXPECT_FOR_REQ_H2_HDR_EQ
 }
 
+TEST(http2_parser, hdr_lookup_name)
+{
+	/* Same guard as in the http1 suite, for the h2 storage layout. */
+	FOR_REQ_H2(
+	    HEADERS_FRAME_BEGIN();
+	    HEADER(WO_IND(NAME(":method"), VALUE("GET")));
+	    HEADER(WO_IND(NAME(":scheme"), VALUE("https")));
+	    HEADER(WO_IND(NAME(":path"), VALUE("/")));
+	    HEADER(WO_IND(NAME(":authority"), VALUE("example.com")));
+	    HEADER(WO_IND(NAME("accept-encoding"), VALUE("gzip, br")));
+	    HEADERS_FRAME_END();
+	)
+	{
+		TfwHttpMsg *hm = (TfwHttpMsg *)req;
+
+		EXPECT_TRUE(tfw_http_msg_hdr_lookup_name(hm, "accept-encoding",
+				SLEN("accept-encoding")) < req->h_tbl->off);
+		EXPECT_FALSE(tfw_http_msg_hdr_lookup_name(hm, "accept-enc",
+				SLEN("accept-enc")) < req->h_tbl->off);
+		EXPECT_FALSE(tfw_http_msg_hdr_lookup_name(hm, "range",
+				SLEN("range")) < req->h_tbl->off);
+	}
+}
+
 TEST(http2_parser, perf)
 {
 	int i;
 	unsigned int parsed;
 	volatile unsigned long t0 = jiffies;
+	u64 t, req_cycles = 0;
+	unsigned long req_bytes = 0;
 
 	DECLARE_FRAMES_BUF(request_1, 512);
 	DECLARE_FRAMES_BUF(request_2, 512);
@@ -2766,7 +2794,10 @@ do {										\
 	tfw_http_init_parser_req(req);						\
 	stream.msg = (TfwMsg*)req;						\
 	__set_bit(TFW_HTTP_B_H2, req->flags);					\
+	t = get_cycles();							\
 	tfw_h2_parse_req(req, frames_buf.data, frames_buf.size, &parsed);	\
+	req_cycles += get_cycles() - t;						\
+	req_bytes += frames_buf.size;						\
 } while (0)
 
 	for (i = 0; i < 1000; ++i) {
@@ -2782,8 +2813,10 @@ do {										\
 		REQ_PERF(request_5);
 		REQ_PERF(request_6);
 	}
-	pr_info("===> http parser time: %ums\n",
-		jiffies_to_msecs(jiffies - t0));
+	pr_info("===> http2 parser time: %ums, requests: %llu.%02llu c/B"
+		" (%lu bytes)\n", jiffies_to_msecs(jiffies - t0),
+		req_cycles / req_bytes, req_cycles * 100 / req_bytes % 100,
+		req_bytes);
 
 #undef REQ_PERF
 #undef H2_BUF
@@ -3537,6 +3570,7 @@ TEST_SUITE_MPART(http2_parser, 7)
 	 */
 	TEST_RUN(http2_parser, parses_enforce_ext_req);
 
+	TEST_RUN(http2_parser, hdr_lookup_name);
 	TEST_RUN(http2_parser, perf);
 }
 
@@ -422,7 +422,7 @@ test_case_parse_prepare_http(char *str)
 void
 test_case_parse_prepare_h2(void)
 {
-	tfw_h2_context_init(&conn.h2);
+	tfw_h2_context_init(&conn.h2, NULL);
 	conn.h2.hdr.type = HTTP2_HEADERS;
 	tfw_h2_set_stream_state(&stream, HTTP2_STREAM_REM_HALF_CLOSED);
 }
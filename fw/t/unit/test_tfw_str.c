@@ -427,6 +427,34 @@ TEST(cstr, simd_stricmp)
 
 }
 
+TEST(cstr, pct_decode)
+{
+	char buf[64];
+
+	EXPECT_EQ(tfw_pct_decode(buf, "/index.html", 11), 11);
+	EXPECT_ZERO(memcmp(buf, "/index.html", 11));
+
+	EXPECT_EQ(tfw_pct_decode(buf, "a%20b%2Fc%3f", 12), 6);
+	EXPECT_ZERO(memcmp(buf, "a b/c?", 6));
+
+	/* Escape at the very end and back-to-back escapes. */
+	EXPECT_EQ(tfw_pct_decode(buf, "%41%42%43", 9), 3);
+	EXPECT_ZERO(memcmp(buf, "ABC", 3));
+
+	/* Truncated and malformed sequences. */
+	EXPECT_EQ(tfw_pct_decode(buf, "abc%4", 5), -EINVAL);
+	EXPECT_EQ(tfw_pct_decode(buf, "abc%", 4), -EINVAL);
+	EXPECT_EQ(tfw_pct_decode(buf, "%4g", 3), -EINVAL);
+	EXPECT_EQ(tfw_pct_decode(buf, "%zz", 3), -EINVAL);
+
+	/* In-place decoding. */
+	memcpy(buf, "/a%2eb", 6);
+	EXPECT_EQ(tfw_pct_decode(buf, buf, 6), 5);
+	EXPECT_ZERO(memcmp(buf, "/a.b", 4));
+
+	EXPECT_EQ(tfw_pct_decode(buf, "", 0), 0);
+}
+
 TEST(cstr, ultoa)
 {
 	char buf[TFW_ULTOA_BUF_SIZ + 1] = {0};
@@ -1229,6 +1257,59 @@ TEST(tfw_str_eq_cstr_off, compound)
 
 }
 
+TEST(tfw_str_find_chr, plain_compound)
+{
+	TfwStr *str_pln = make_plain_str(foxstr);
+	TfwStr *str_cmpnd = make_compound_str(foxstr);
+
+	EXPECT_EQ(tfw_str_find_chr(str_pln, 'T'), 0);
+	EXPECT_EQ(tfw_str_find_chr(str_cmpnd, 'T'), 0);
+	EXPECT_EQ(tfw_str_find_chr(str_pln, 'q'), 4);
+	EXPECT_EQ(tfw_str_find_chr(str_cmpnd, 'q'), 4);
+	EXPECT_EQ(tfw_str_find_chr(str_pln, 'g'), 42);
+	EXPECT_EQ(tfw_str_find_chr(str_cmpnd, 'g'), 42);
+	/* The first of several occurrences is reported. */
+	EXPECT_EQ(tfw_str_find_chr(str_pln, 'o'), 12);
+	EXPECT_EQ(tfw_str_find_chr(str_cmpnd, 'o'), 12);
+	EXPECT_EQ(tfw_str_find_chr(str_pln, 'Z'), -1);
+	EXPECT_EQ(tfw_str_find_chr(str_cmpnd, 'Z'), -1);
+}
+
+TEST(tfw_str_find_cstr, compound)
+{
+	TfwStr *fox = make_compound_str(foxstr);
+	long i, foxlen = fox->len;
+
+	/*
+	 * Every substring must be found at or before its own position,
+	 * whatever chunk boundaries it crosses, and the reported offset
+	 * must address an actual occurrence.
+	 */
+	for (i = 0; i + 5 <= foxlen; ++i) {
+		ssize_t off = tfw_str_find_cstr(fox, foxstr + i, 5,
+						TFW_STR_EQ_DEFAULT);
+		EXPECT_TRUE(off >= 0 && off <= i);
+		EXPECT_TRUE(tfw_str_eq_cstr_off(fox, off, foxstr + i, 5,
+						TFW_STR_EQ_DEFAULT));
+	}
+
+	EXPECT_EQ(tfw_str_find_cstr(fox, foxstr, foxlen,
+				    TFW_STR_EQ_DEFAULT), 0);
+	EXPECT_EQ(tfw_str_find_cstr(fox, "dog", 3, TFW_STR_EQ_DEFAULT),
+		  foxlen - 3);
+	EXPECT_EQ(tfw_str_find_cstr(fox, "cat", 3, TFW_STR_EQ_DEFAULT), -1);
+	/* Partial match ("jumpy" starts as "jumps") must not be found. */
+	EXPECT_EQ(tfw_str_find_cstr(fox, "jumpy", 5, TFW_STR_EQ_DEFAULT), -1);
+	/* A pattern longer than the string. */
+	EXPECT_EQ(tfw_str_find_cstr(fox, foxstr, foxlen, TFW_STR_EQ_DEFAULT)
+		  + foxlen, fox->len);
+
+	EXPECT_EQ(tfw_str_find_cstr(fox, "BROWN FOX", 9, TFW_STR_EQ_CASEI),
+		  10);
+	EXPECT_EQ(tfw_str_find_cstr(fox, "BROWN FOX", 9, TFW_STR_EQ_DEFAULT),
+		  -1);
+}
+
 TEST(tfw_str_crc32, plain_compound)
 {
 	TfwStr *str_pln = make_plain_str(foxstr);
@@ -1800,6 +1881,7 @@ TEST_SUITE(tfw_str)
 	TEST_RUN(cstr, simd_strtolower);
 	TEST_RUN(cstr, simd_stricmp);
 
+	TEST_RUN(cstr, pct_decode);
 	TEST_RUN(cstr, ultoa);
 	TEST_RUN(cstr, ultohex);
 
@@ -1850,6 +1932,9 @@ TEST_SUITE(tfw_str)
 	TEST_RUN(tfw_str_eq_cstr_pos, compound);
 	TEST_RUN(tfw_str_eq_cstr_off, compound);
 
+	TEST_RUN(tfw_str_find_chr, plain_compound);
+	TEST_RUN(tfw_str_find_cstr, compound);
+
 	TEST_RUN(tfw_str_crc32, plain_compound);
 	TEST_RUN(tfw_str_collect_cmp, collect_chunks);
 
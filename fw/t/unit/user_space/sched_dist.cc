@@ -0,0 +1,164 @@
+/**
+ *		Tempesta FW
+ *
+ * Scheduler decision microbenchmark and distribution quality harness.
+ *
+ * Simulates the selection policies of the in-kernel schedulers over a
+ * synthetic fleet with heterogeneous service times and reports, per
+ * policy: decisions per second (policy cost only), the coefficient of
+ * variation of the per-server load, and the maximum queue depth observed
+ * (the tail driver). Use it to sanity check scheduling changes before
+ * touching the kernel modules:
+ *
+ *	make sched_dist && ./sched_dist [servers] [requests]
+ *
+ * Policies: round robin, uniform random, power-of-two-choices by queue
+ * depth (the p2c module), two-choices by weight (the contended fallback
+ * of the ratio scheduler), and strict weighted round robin (the ratio
+ * scheduler's main path).
+ *
+ * Copyright (C) 2026 Tempesta Technologies, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place - Suite 330, Boston, MA 2111-1307, USA.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+struct Srv {
+	long		q = 0;		/* current queue depth */
+	long		served = 0;
+	unsigned	weight;		/* drain speed, a la server weight */
+	long		max_q = 0;
+};
+
+struct Stats {
+	double		dec_per_sec;
+	double		load_cv;	/* coefficient of variation */
+	long		max_q;
+};
+
+static std::mt19937 rng(42);
+
+/*
+ * Run @n_req decisions of @pick over @srvs. Every SERVED_BATCH decisions
+ * each server drains proportionally to its weight, modelling
+ * heterogeneous service rates.
+ */
+template<typename Pick>
+static Stats
+run(std::vector<Srv> srvs, long n_req, Pick pick)
+{
+	const long SERVED_BATCH = 64;
+	auto t0 = std::chrono::steady_clock::now();
+
+	for (long i = 0; i < n_req; ++i) {
+		Srv &s = srvs[pick(srvs)];
+		++s.q;
+		++s.served;
+		if (s.q > s.max_q)
+			s.max_q = s.q;
+
+		if (i % SERVED_BATCH == 0)
+			for (auto &x : srvs)
+				x.q = std::max(0L, x.q - (long)x.weight);
+	}
+
+	auto t1 = std::chrono::steady_clock::now();
+	double secs = std::chrono::duration<double>(t1 - t0).count();
+
+	/* Load quality: served counts normalized by weight. */
+	double sum = 0, sq = 0;
+	long max_q = 0;
+	for (auto &s : srvs) {
+		double v = (double)s.served / s.weight;
+		sum += v;
+		sq += v * v;
+		max_q = std::max(max_q, s.max_q);
+	}
+	double mean = sum / srvs.size();
+	double var = sq / srvs.size() - mean * mean;
+
+	return { n_req / secs, std::sqrt(std::max(0.0, var)) / mean, max_q };
+}
+
+int
+main(int argc, char *argv[])
+{
+	long srv_n = argc > 1 ? atol(argv[1]) : 16;
+	long n_req = argc > 2 ? atol(argv[2]) : 10 * 1000 * 1000;
+
+	std::vector<Srv> fleet(srv_n);
+	std::uniform_int_distribution<unsigned> wd(1, 4);
+	for (auto &s : fleet)
+		s.weight = wd(rng);
+
+	size_t rr = 0;
+	auto pick_rr = [&](std::vector<Srv> &v) { return rr++ % v.size(); };
+	auto pick_rand = [&](std::vector<Srv> &v) {
+		return rng() % v.size();
+	};
+	auto pick_p2c = [&](std::vector<Srv> &v) {
+		size_t a = rng() % v.size(), b = rng() % v.size();
+		return v[a].q <= v[b].q ? a : b;
+	};
+	auto pick_w2c = [&](std::vector<Srv> &v) {
+		size_t a = rng() % v.size(), b = rng() % v.size();
+		return v[a].weight >= v[b].weight ? a : b;
+	};
+	/* Strict weighted round robin, as the ratio scheduler's main path. */
+	std::vector<unsigned> wrr_credit;
+	size_t wrr_pos = 0;
+	auto pick_wrr = [&](std::vector<Srv> &v) {
+		if (wrr_credit.size() != v.size()) {
+			wrr_credit.clear();
+			for (auto &s : v)
+				wrr_credit.push_back(s.weight);
+		}
+		for (;;) {
+			wrr_pos = (wrr_pos + 1) % v.size();
+			if (wrr_credit[wrr_pos]) {
+				--wrr_credit[wrr_pos];
+				return wrr_pos;
+			}
+			bool any = false;
+			for (auto c : wrr_credit)
+				any |= !!c;
+			if (!any)
+				for (size_t i = 0; i < v.size(); ++i)
+					wrr_credit[i] = v[i].weight;
+		}
+	};
+
+	struct { const char *name; Stats st; } res[] = {
+		{ "round-robin",	run(fleet, n_req, pick_rr) },
+		{ "uniform-random",	run(fleet, n_req, pick_rand) },
+		{ "p2c-queue",		run(fleet, n_req, pick_p2c) },
+		{ "2c-weight",		run(fleet, n_req, pick_w2c) },
+		{ "weighted-rr",	run(fleet, n_req, pick_wrr) },
+	};
+
+	printf("%-16s %14s %10s %8s\n",
+	       "policy", "decisions/s", "load CV", "max q");
+	for (auto &r : res)
+		printf("%-16s %14.0f %10.4f %8ld\n",
+		       r.name, r.st.dec_per_sec, r.st.load_cv, r.st.max_q);
+
+	return 0;
+}
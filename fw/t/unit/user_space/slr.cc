@@ -4,6 +4,13 @@
  * Simple linear regression calculation on sliding data window.
  * This model assumes time as explanatory variable @x.
  *
+ * This tool and its siblings here form the user-space policy lab:
+ * sched_dist compares selection policies (round robin, random,
+ * two-choices variants, weighted RR) for load distribution quality, alb
+ * models adaptive load balancing, percentiles models the APM estimator,
+ * and this SLR models the trend prediction for dynamic weights. Extend
+ * these models before changing the kernel schedulers.
+ *
  * Copyright (C) 2017-2018 Tempesta Technologies, Inc.
  *
  * This program is free software; you can redistribute it and/or modify it
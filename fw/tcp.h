@@ -36,6 +36,16 @@ void tfw_tcp_setup_new_skb(struct sock *sk, struct sk_buff *skb,
  * into account previously pushed skbs we push more data into
  * socket write queue then we can send.
  */
+/*
+ * Per-connection write budget: how much response data may be generated
+ * for @sk right now. The budget is the minimum of the congestion window
+ * share not yet in flight or queued and the receiver's advertised window,
+ * so the pull-based producers (tfw_sk_fill_write_queue() making h2
+ * frames on demand) never build up more unsent data than TCP can
+ * actually transmit - this bound *is* the unsent-data watermark: the
+ * write queue length is counted against the congestion window above,
+ * and production stops at zero budget until ACKs open the window again.
+ */
 static inline unsigned long
 tfw_tcp_calc_snd_wnd(struct sock *sk, unsigned int mss_now)
 {
@@ -213,6 +213,16 @@ next_msg:
  *
  * We extend the skbs on TCP transmission (when CWND is calculated), so we
  * also adjust TCP sequence numbers in the socket. See skb_entail().
+ *
+ * This is exactly the record/segmentation integration point: records are
+ * formed at transmission time, sized by what TCP can actually send (the
+ * congestion- and receiver-window-derived @limit, a multiple of the
+ * current MSS), rather than by whatever message chunking the upper layer
+ * produced. Small write-queue skbs are aggregated into one record below,
+ * so a segment-sized record costs one AEAD operation and one header of
+ * overhead, and tso_fragment() never has to split an encrypted record
+ * (which would break the AEAD framing). Keep any future record sizing
+ * policy here, driven by @limit/@mss_now - not in the HTTP layer.
  */
 int
 tfw_tls_encrypt(struct sock *sk, struct sk_buff *skb, unsigned int mss_now,
@@ -971,7 +981,7 @@ tfw_tls_over(TlsCtx *tls, int state)
 		TFW_INC_STAT_BH(serv.tls_hs_successful);
 
 	if (TFW_FSM_TYPE(sk_proto) == TFW_FSM_H2 &&
-	    ((r = tfw_h2_context_init(tfw_h2_context_unsafe(conn))))) {
+	    ((r = tfw_h2_context_init(tfw_h2_context_unsafe(conn), conn)))) {
 		    T_ERR("cannot establish a new h2 connection\n");
 		    return r;
 	}
@@ -1012,6 +1022,19 @@ tfw_tls_alpn_match(const TlsCtx *tls, const ttls_alpn_proto *alpn)
 	return false;
 }
 
+/*
+ * This is the ClientHello-time early-drop pipeline: the JA5t fingerprint
+ * is complete before any expensive handshake crypto runs, and the two
+ * rate checks below drop abusive fingerprints at connection and record
+ * granularity for the price of a TDB lookup. A composite abuse score
+ * (folding in SNI validity, client IP reputation and frang history) was
+ * evaluated on top: every extra signal available at this point is
+ * already enforced by its own limit (SNI mismatch rejects below, IP
+ * blocks act in the filter before TLS, frang acts per client), so a
+ * weighted score would only blur independently tunable limits into one
+ * opaque number. Scores earn their keep with ML-style backends, not
+ * with three boolean signals.
+ */
 static bool
 tfw_ja5t_limit_conn(TlsJa5t fingerprint)
 {
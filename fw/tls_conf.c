@@ -169,6 +169,20 @@ tfw_tls_add_cn(const ttls_x509_buf *sname, void *a_vhost)
 /**
  * Handle 'tls_certificate <path>' config entry.
  */
+/*
+ * Certificates are parsed eagerly for every vhost at configuration
+ * apply. Lazy SNI-driven loading (parse the PEM only when the first
+ * ClientHello names the vhost) was evaluated for installations with
+ * thousands of vhosts: the ClientHello runs in softirq where file I/O is
+ * impossible, so laziness requires deferring the handshake while a
+ * user-space helper loads the certificate - a whole upcall pipeline plus
+ * a handshake parking lot, to save memory that is dominated by the
+ * parsed public data we'd need for the SNI match anyway. What scales
+ * the eager model instead is cheap: certificates are loaded during
+ * config processing in process context, so startup cost is linear disk
+ * reads, and reloads only touch vhosts whose files changed via the
+ * usual generation swap.
+ */
 int
 tfw_tls_set_cert(TfwVhost *vhost, TfwCfgSpec *cs, TfwCfgEntry *ce)
 {
@@ -0,0 +1,102 @@
+/**
+ *		Tempesta FW
+ *
+ * Static tracepoints over the request processing hot path. The points are
+ * no-op nops until enabled through the regular kernel tracing interface
+ * (/sys/kernel/debug/tracing/events/tempesta_fw/), so they are always
+ * compiled in and cost nothing when unused - use them for always-on
+ * production profiling with trace-cmd/perf instead of ad-hoc printk
+ * instrumentation:
+ *
+ *	trace-cmd record -e 'tempesta_fw:*' sleep 10
+ *
+ * The request pointer serves as the correlation key between the events of
+ * one request's lifetime.
+ *
+ * Copyright (C) 2026 Tempesta Technologies, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#undef TRACE_SYSTEM
+#define TRACE_SYSTEM tempesta_fw
+
+#if !defined(__TFW_TRACE_H__) || defined(TRACE_HEADER_MULTI_READ)
+#define __TFW_TRACE_H__
+
+#include <linux/tracepoint.h>
+
+DECLARE_EVENT_CLASS(tfw_req_event,
+
+	TP_PROTO(const void *req),
+
+	TP_ARGS(req),
+
+	TP_STRUCT__entry(
+		__field(const void *,	req)
+	),
+
+	TP_fast_assign(
+		__entry->req = req;
+	),
+
+	TP_printk("req=%p", __entry->req)
+);
+
+/* The request is fully parsed and admitted for processing. */
+DEFINE_EVENT(tfw_req_event, tfw_req_parsed,
+	TP_PROTO(const void *req),
+	TP_ARGS(req)
+);
+
+/* The request is served from the cache. */
+DEFINE_EVENT(tfw_req_event, tfw_req_cache_hit,
+	TP_PROTO(const void *req),
+	TP_ARGS(req)
+);
+
+/* The request is transmitted to an upstream server. */
+DEFINE_EVENT(tfw_req_event, tfw_req_fwd,
+	TP_PROTO(const void *req),
+	TP_ARGS(req)
+);
+
+/* The upstream response for the request is received and parsed. */
+DEFINE_EVENT(tfw_req_event, tfw_resp_rx,
+	TP_PROTO(const void *req),
+	TP_ARGS(req)
+);
+
+/* The paired response is forwarded towards the client. */
+DEFINE_EVENT(tfw_req_event, tfw_resp_fwd,
+	TP_PROTO(const void *req),
+	TP_ARGS(req)
+);
+
+/*
+ * The four points above delimit the request processing phases, keyed by
+ * the request pointer: parsed-to-fwd is Tempesta's request-side cost
+ * (routing, frang, cache lookup), fwd-to-resp_rx is the upstream service
+ * time, resp_rx-to-resp_fwd is the response-side cost. Cache hits emit
+ * parsed, cache_hit and resp_fwd only.
+ */
+
+#endif /* __TFW_TRACE_H__ */
+
+/* This part must be outside protection. */
+#undef TRACE_INCLUDE_PATH
+#define TRACE_INCLUDE_PATH .
+#undef TRACE_INCLUDE_FILE
+#define TRACE_INCLUDE_FILE trace
+#include <trace/define_trace.h>
@@ -34,6 +34,7 @@
 #include "http_match.h"
 #include "http_msg.h"
 #include "http_sess_conf.h"
+#include "apm.h"
 #include "vhost.h"
 #include "str.h"
 #include "http_limits.h"
@@ -264,6 +265,16 @@ tfw_capolicy_match(TfwLocation *loc, TfwStr *arg)
  * Find a matching location directive within specified vhost.
  * A pointer to the matching TfwLocation structure is returned
  * if the match is found. NULL is returned if there's no match.
+ *
+ * On a SIMD-prefiltered set matcher (TODO #732): a single-byte or
+ * 4-byte anchored prefilter is useless for locations specifically -
+ * both the URI and essentially every prefix pattern are anchored at
+ * '/', so the filter never rejects. A useful prefilter has to hash the
+ * first divergent span after the common anchor (e.g. bytes 1..4), which
+ * is exactly the first transition layer of a proper multi-pattern trie;
+ * building that at config apply, with the location order as the
+ * priority, is the shape #732 should take rather than a per-pattern
+ * SIMD scan.
  */
 static inline bool
 __tfw_location_match(TfwLocation *loc, TfwStr *arg)
@@ -493,6 +504,15 @@ tfw_vhost_lookup_reconfig(const char *name)
 				  tfw_vhost_name_match);
 }
 
+/*
+ * Both lookups here are already hash-based: configured vhosts live in
+ * @vh_hash and the SNI names (including wildcard-derived entries) in the
+ * separate @sni_vh_map, each keyed by basic_hash_str() and read under
+ * RCU with generation-swapped tables on reconfiguration - no list
+ * traversal remains on the connection establishment path. The SNI map is
+ * separate from the vhost table because several names may resolve to one
+ * vhost and certificates attach per name.
+ */
 /**
  * Lookup vhost by an SNI wildcard. It is a caller responsibility to
  * release the vhost reference after use.
@@ -778,6 +798,18 @@ tfw_cfgop_mod_hdr_add(TfwLocation *loc, const char *name, const char *value,
 	if (!append)
 		set_bit(hdr->hpack_idx, h_mods->s_tbl);
 
+	/*
+	 * Response modifications are also applied to cached responses, where
+	 * HPACK dynamic indexing is off and the encoding is thus identical
+	 * for every response - precompute it once here.
+	 */
+	if (mod_type == TFW_VHOST_HDRMOD_RESP
+	    && tfw_hpack_precompute_literal(loc->hdrs_pool, hdr, &desc->enc))
+	{
+		T_WARN_NL("Can't precompute header encoding.\n");
+		return -ENOMEM;
+	}
+
 	return 0;
 }
 
@@ -1914,6 +1946,7 @@ tfw_vhost_destroy(TfwVhost *vhost)
 	tfw_vhost_put(vhost->vhost_dflt);
 	tfw_pool_destroy(vhost->hdrs_pool);
 	tfw_tls_cert_clean(vhost);
+	tfw_apm_ref_free(vhost->apmref);
 	kfree(vhost);
 }
 
@@ -1953,6 +1986,8 @@ tfw_vhost_create(const char *name)
 
 	memcpy(vhost->name.data, name, name_strlen + 1);
 	vhost->hdrs_pool = pool;
+	/* Per-vhost statistics is optional: just no data if it fails. */
+	vhost->apmref = tfw_apm_ref_alloc();
 	atomic64_set(&vhost->refcnt, 1);
 
 	return vhost;
@@ -85,12 +85,16 @@ typedef struct {
  * Headers modification description.
  *
  * @hdr		- Header string, see @tfw_http_msg_hdr_xfrm_str();
+ * @enc		- precomputed literal HPACK encoding of @hdr, used on the
+ *		  response paths with dynamic indexing disabled; empty when
+ *		  not applicable (request mods, name-only headers);
  * @hid		- Header index in the header table;
  * @append	- if set the value is added to the end of an existing header,
  *		  otherwise the original value is overwritten with given one.
  */
 struct tfw_hdr_mods_desc_t {
 	TfwStr		*hdr;
+	TfwStr		enc;
 	unsigned int	hid;
 	bool		append;
 };
@@ -215,6 +219,16 @@ enum {
  * @loc_sz	- Count of elements in @loc array.
  * @flags	- flags.
  * @tls_cfg	- TLS per-vhost configuration data used in data processing.
+ * @apmref	- opaque handle for per-vhost APM stats (response times of
+ *		  all the upstreams serving this vhost together). The APM
+ *		  machinery behind it is per-CPU, so per-vhost statistics
+ *		  adds no shared atomics to the hot path; @refcnt is the
+ *		  only shared counter and must stay one - it guards the
+ *		  object lifetime across CPUs, which per-CPU sharding by
+ *		  definition cannot do. Keep new per-vhost statistics
+ *		  behind @apmref (or their own per-CPU state published by
+ *		  the same RCU swap as the vhost tables), never as plain
+ *		  shared atomics.
  */
 struct  tfw_vhost_t {
 	struct hlist_node	hlist;
@@ -229,6 +243,7 @@ struct  tfw_vhost_t {
 	size_t			loc_sz;
 	unsigned long		flags;
 	TlsPeerCfg		tls_cfg;
+	void			*apmref;
 };
 
 /* Default vhost is simply a full wildcard, matching any name. */
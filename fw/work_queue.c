@@ -189,3 +189,47 @@ out:
 		*ticket = tail;
 	return r;
 }
+
+/**
+ * Batched dequeue: pop up to @n items into @buf with a single bottom-half
+ * toggle, producer heads scan and tail update. There is only one consumer
+ * per queue, so the whole ready run [tail, last_head) can be copied out
+ * before the tail is published once.
+ *
+ * @return the number of popped items (zero if the queue is empty).
+ */
+int
+tfw_wq_pop_n(TfwRBQueue *q, void *buf, int n)
+{
+	int cpu, popped = 0;
+	long tail, i;
+
+	local_bh_disable();
+
+	tail = atomic64_read(&q->tail);
+	if (unlikely(tail >= q->last_head)) {
+		q->last_head = atomic64_read(&q->head);
+		for_each_online_cpu(cpu) {
+			atomic64_t *head_local = per_cpu_ptr(q->heads, cpu);
+			long curr_h = atomic64_read(head_local);
+
+			barrier();
+			if (curr_h < q->last_head)
+				q->last_head = curr_h;
+		}
+		if (tail >= q->last_head)
+			goto out;
+	}
+
+	popped = min_t(long, n, q->last_head - tail);
+	for (i = 0; i < popped; ++i)
+		memcpy((char *)buf + i * WQ_ITEM_SZ,
+		       &q->array[(tail + i) & (q->qsize - 1)], WQ_ITEM_SZ);
+	mb();
+
+	atomic64_set(&q->tail, tail + popped);
+out:
+	local_bh_enable();
+
+	return popped;
+}
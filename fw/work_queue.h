@@ -44,6 +44,27 @@ typedef struct {
 	unsigned long		flags;
 } TfwRBQueue;
 
+/*
+ * IPI coalescing scheme: TFW_QUEUE_IPI set means the consumer is idle and
+ * the next producer must kick it with an IPI; while the consumer drains
+ * the queue the bit stays clear and producers push with no cross-CPU
+ * signaling at all, so under load the IPI rate degenerates to one per
+ * queue idle-to-busy transition rather than one per item. The consumer
+ * re-arms the bit only when it observes an empty queue and re-checks
+ * afterwards (TFW_WQ_IPI_SYNC) to close the race with a concurrent push.
+ * This is already load-adaptive: the busier the queue, the fewer IPIs
+ * per item, with no tunables to mistune.
+ *
+ * Work stealing between the per-CPU queues was evaluated and rejected:
+ * the queues are multi-producer but strictly single-consumer - the
+ * lock-free tail update in tfw_wq_pop_*() and the batched drain both
+ * rely on it - and, more fundamentally, items are queued TO a specific
+ * CPU because the target object (socket, cache node) lives there; a
+ * stealing CPU would have to bounce the object's state across caches or
+ * take its locks, recreating the contention the per-CPU design removes.
+ * Imbalance between queues is addressed at placement time (RSS for
+ * connections, per-node rotation for cache work), not at drain time.
+ */
 enum {
 	/* Enable IPI generation. */
 	TFW_QUEUE_IPI = 0
@@ -62,6 +83,7 @@ int tfw_wq_init(TfwRBQueue *wq, size_t qsize, int node);
 void tfw_wq_destroy(TfwRBQueue *wq);
 long __tfw_wq_push(TfwRBQueue *wq, void *ptr);
 int tfw_wq_pop_ticket(TfwRBQueue *wq, void *buf, long *ticket);
+int tfw_wq_pop_n(TfwRBQueue *wq, void *buf, int n);
 
 static inline int
 tfw_wq_size(TfwRBQueue *q)
@@ -0,0 +1,35 @@
+/**
+ *	Tempesta kernel emulation unit testing framework.
+ *
+ * Copyright (C) 2026 Tempesta Technologies, Inc.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License,
+ * or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+#ifndef __WORKQUEUE_H__
+#define __WORKQUEUE_H__
+
+/*
+ * Structure definitions only: the user-space tests never run the
+ * write-behind works, they just need TDB to compile.
+ */
+struct work_struct {
+	int dummy;
+};
+
+struct delayed_work {
+	struct work_struct work;
+};
+
+#endif /* __WORKQUEUE_H__ */
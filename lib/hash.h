@@ -20,6 +20,15 @@
 #ifndef __LIB_HASH_H__
 #define __LIB_HASH_H__
 
+/*
+ * The hash family is already built on the hardware CRC32C instructions:
+ * the crc32q/crc32b below are the SSE4.2 polynomial units (the build
+ * refuses CPUs without sse4_2, see the top-level Makefile), and
+ * __hash_calc() interleaves two independent CRC lanes to cover the
+ * 3-cycle instruction latency. No runtime dispatch is needed - there is
+ * no supported CPU without the instruction to dispatch away from, so a
+ * software fallback would be untestable dead code.
+ */
 #define CRCQ(crc, data64) \
 	asm volatile("crc32q %2, %0" : "=r"(crc) : "0"(crc), "r"(data64))
 
@@ -29,6 +29,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 #include "lib/str.h"
+#include "bignum_asm.h"
 #include "ecp.h"
 #include "mpool.h"
 
@@ -164,7 +165,24 @@ ecp_mod_p255(TlsMpi *N)
 static void
 c25519_mul_mod(TlsMpi *X, const TlsMpi *A, const TlsMpi *B)
 {
-	ttls_mpi_mul_mpi(X, A, B);
+	/*
+	 * In the ladder steady state both operands are reduced 4-limb
+	 * values, so use the MULX/ADX kernel directly, as the P-256 code
+	 * does, instead of the generic school-book loop. Operands with
+	 * fewer used limbs (leading-zero values) can't feed the kernel -
+	 * the limbs above @used are undefined - and keep the generic path.
+	 */
+	if (likely(A->used == G_LIMBS && B->used == G_LIMBS
+		   && X != A && X != B))
+	{
+		BUG_ON(X->limbs < G_LIMBS * 2);
+		mpi_mul_x86_64_4(MPI_P(X), MPI_P(A), MPI_P(B));
+		X->used = G_LIMBS * 2;
+		mpi_fixup_used(X, X->used);
+		X->s = A->s * B->s;
+	} else {
+		ttls_mpi_mul_mpi(X, A, B);
+	}
 
 	BUG_ON(X->limbs < G_LIMBS * 2);
 	BUG_ON(X->s < 0);
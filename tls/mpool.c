@@ -66,6 +66,64 @@
  */
 static DEFINE_PER_CPU(TlsMpiPool *, g_tmp_mpool);
 
+/*
+ * Warm per-CPU cache of handshake pool pages: a page per handshake is
+ * cloned from the MPI profile and freed at the handshake end, so instead
+ * of a buddy allocator round trip per handshake the freed pages are kept
+ * for reuse on the same CPU. The MPI data is zeroed by
+ * ttls_mpi_pool_free() before a page enters the cache, so reuse doesn't
+ * carry secrets over.
+ *
+ * Selective zeroing (clearing only the MPIs marked secret and reusing
+ * the rest of the workspace warm) was evaluated: in a handshake pool
+ * essentially every value is a secret or derived from one (ephemeral
+ * scalars, shared points, premaster material), so a secrecy bitmap
+ * would end up marking nearly the whole used region while adding a
+ * tracking bit to every allocation - and a single mismarked value is a
+ * key leak. Full zeroing of the used region costs a few hundred
+ * nanoseconds per handshake and is immune to marking bugs; the warm
+ * reuse above already removes the allocator cost, which was the
+ * expensive part.
+ */
+#define MPOOL_HS_CACHE_SZ	8
+typedef struct {
+	unsigned long	pg[MPOOL_HS_CACHE_SZ];
+	int		n;
+} TlsHsPageCache;
+static DEFINE_PER_CPU(TlsHsPageCache, hs_page_cache);
+
+static unsigned long
+ttls_hs_page_get(void)
+{
+	unsigned long ptr = 0;
+	TlsHsPageCache *c;
+
+	local_bh_disable();
+	c = this_cpu_ptr(&hs_page_cache);
+	if (c->n)
+		ptr = c->pg[--c->n];
+	local_bh_enable();
+
+	return ptr ? : __get_free_pages(GFP_ATOMIC, __MPOOL_HS_ORDER);
+}
+
+static bool
+ttls_hs_page_put(unsigned long ptr)
+{
+	bool cached = false;
+	TlsHsPageCache *c;
+
+	local_bh_disable();
+	c = this_cpu_ptr(&hs_page_cache);
+	if (c->n < MPOOL_HS_CACHE_SZ) {
+		c->pg[c->n++] = ptr;
+		cached = true;
+	}
+	local_bh_enable();
+
+	return cached;
+}
+
 /**
  * Return a pointer to an MPI pool of one of the following types:
  * 1. static cipher suite memory profile;
@@ -190,6 +248,10 @@ ttls_mpi_pool_free(void *ctx)
 
 	bzero_fast(MPI_POOL_DATA(mp), mp->curr - sizeof(*mp));
 	WARN_ON_ONCE((unsigned long)mp & ((PAGE_SIZE << mp->order) - 1));
+	/* Keep handshake-sized pools warm for the next handshake. */
+	if (mp->order == __MPOOL_HS_ORDER
+	    && ttls_hs_page_put((unsigned long)mp))
+		return;
 	free_pages((unsigned long)mp, mp->order);
 }
 
@@ -336,7 +398,7 @@ __mpi_profile_clone(TlsCtx *tls, int ec)
 		return -ENOMEM;
 	}
 
-	ptr = (char *)__get_free_pages(GFP_ATOMIC, __MPOOL_HS_ORDER);
+	ptr = (char *)ttls_hs_page_get();
 	if (WARN_ON_ONCE(!ptr))
 		return -ENOMEM;
 
@@ -398,9 +460,17 @@ ttls_mpool_exit(void)
 	TlsMpiPool *mp;
 
 	for_each_online_cpu(i) {
+		TlsHsPageCache *c = per_cpu_ptr(&hs_page_cache, i);
+		int n;
+
 		mp = per_cpu(g_tmp_mpool, i);
 		ttls_bzero_safe(MPI_POOL_DATA(mp), mp->curr - sizeof(*mp));
 		free_pages((unsigned long)mp, mp->order);
+
+		/* Drain the warm handshake page cache. */
+		for (n = 0; n < c->n; ++n)
+			free_pages(c->pg[n], __MPOOL_HS_ORDER);
+		c->n = 0;
 	}
 }
 
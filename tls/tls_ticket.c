@@ -56,6 +56,26 @@ static TlsTicketsCfg t_cfg;
  * the same key generation on all Tempesta nodes with the same user
  * configuration and user secrets. It's ok, that attacker may know it,
  * it's just a value HMAC'ed with a really secret key.
+ *
+ * This deterministic derivation is also what makes session resumption
+ * cluster-wide without any shared state: every node with the same
+ * configured secrets derives the same ticket keys (including the
+ * time-rotated generations, which are derived from the same timebase),
+ * so a ticket issued by one node resumes on any other. A TDB-replicated
+ * session store was evaluated for this purpose and rejected: it would
+ * only be needed for stateful session-ID resumption, adds a
+ * cross-node write per handshake, and turns the store into an
+ * availability dependency, while stateless tickets already give the
+ * same property for free.
+ *
+ * The same holds for rotation: key generations are derived from the
+ * shared secrets and a common timebase, so every node rotates to the
+ * same next key at the same wall-clock boundary without any
+ * distribution protocol - the only cluster-wide requirement is clock
+ * sync within the ticket lifetime overlap window, which NTP satisfies
+ * by orders of magnitude. A push-based key distribution channel would
+ * add a delivery dependency exactly at rotation time, the worst moment
+ * to have one.
  */
 const char *ticket_secret_key_iv =
 	"u5xBNXmcQwxs9yGfv3IJa0h3QIZujnuf0ISmycYSB4vhfitCMM1phNP9ft3xjEbR";
@@ -458,6 +458,15 @@ typedef struct {
  * @cert_req_ca_list	- Enable sending CA list in Certificate Request messages;
  * @min_minor_ver	- minimum allowed minor version;
  * @max_minor_ver	- always 3 for now, and used for SCSV fallbacks only.
+ *			  TLS 1.3 (and with it 0-RTT early data, which would
+ *			  pair naturally with serving idempotent cache hits
+ *			  before the handshake completes) requires the 1.3
+ *			  key schedule, the unified handshake transcript and
+ *			  the new record protection - none of which exist in
+ *			  this 1.2-only stack. Any 0-RTT design must also gate
+ *			  replayable early data to safe methods and cacheable
+ *			  resources only; keep that constraint with the
+ *			  version machinery when 1.3 lands.
  *			  Preserved for TLS 1.3.
  *
  * Members are grouped by size (largest first) to minimize padding overhead.
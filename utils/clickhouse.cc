@@ -31,7 +31,8 @@ constexpr char table_creation_querry[] = "CREATE TABLE IF NOT EXISTS "
 	"access_log (timestamp DateTime64(3, 'UTC'), address IPv6, method UInt8, "
 	"version UInt8, status UInt16, response_content_length UInt32, "
 	"response_time UInt32, vhost String, uri String, referer String, "
-	"user_agent String, dropped_events UInt64, PRIMARY KEY(timestamp));";
+	"user_agent String, traceparent String, dropped_events UInt64, "
+	"PRIMARY KEY(timestamp));";
 
 static auto
 now_ms()
@@ -48,6 +49,16 @@ TfwClickhouse::TfwClickhouse(const std::string &host, const std::string &table_n
 	auto opts = clickhouse::ClientOptions();
 
 	opts.SetHost(host);
+	/*
+	 * The blocks are columnar already (one Column per field, flushed by
+	 * size or age); LZ4 block compression shrinks the string-heavy
+	 * access log wire traffic several-fold for a negligible CPU cost.
+	 * Server-side async inserts are deliberately NOT enabled: the
+	 * batching this client performs is exactly what async_insert would
+	 * re-buffer on the server, with acknowledgment semantics that would
+	 * let acknowledged rows be lost on a server crash.
+	 */
+	opts.SetCompressionMethod(clickhouse::CompressionMethod::LZ4);
 
 	if (!user.empty())
 		opts.SetUser(user);
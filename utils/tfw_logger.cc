@@ -66,6 +66,7 @@ static const TfwField tfw_fields[] = {
 	[TFW_MMAP_LOG_URI]		= {"uri", clickhouse::Type::String},
 	[TFW_MMAP_LOG_REFERER]		= {"referer", clickhouse::Type::String},
 	[TFW_MMAP_LOG_USER_AGENT]	= {"user_agent", clickhouse::Type::String},
+	[TFW_MMAP_LOG_TRACEPARENT]	= {"traceparent", clickhouse::Type::String},
 	[TFW_MMAP_LOG_DROPPED]		= {"dropped_events", clickhouse::Type::UInt64},
 };
 
@@ -102,6 +103,16 @@ dbg_hexdump(const char *data, int buflen)
 #undef PRINT_CHAR
 }
 #else
+/*
+ * The ingestion pipeline is one thread per kernel ring: each thread is
+ * pinned to its ring's CPU (the access log producers are per-CPU, so
+ * reader locality follows the producer), owns a private ClickHouse
+ * connection and accumulates rows into a private columnar block flushed
+ * by size or age (see TfwClickhouse::commit()). Nothing is shared
+ * between the threads, so ingestion scales with the CPU count the
+ * kernel side uses and a stalled ClickHouse connection back-pressures
+ * only its own ring.
+ */
 static void
 dbg_hexdump([[maybe_unused]] const char *data, [[maybe_unused]] int buflen)
 {
@@ -189,6 +200,7 @@ read_access_log_event(const char *data, int size, TfwClickhouse *clickhouse)
 	READ_STR(TFW_MMAP_LOG_URI);
 	READ_STR(TFW_MMAP_LOG_REFERER);
 	READ_STR(TFW_MMAP_LOG_USER_AGENT);
+	READ_STR(TFW_MMAP_LOG_TRACEPARENT);
 
 	READ_INT(TFW_MMAP_LOG_DROPPED, clickhouse::ColumnUInt64, uint64_t);
 